@@ -1,8 +1,11 @@
 #include "AssetManager.h"
 #include "ECS/Components.h"
+#include "constants.h"
+#include "JobSystem.h"
 #include <iostream> 
 #include <SDL_mixer.h> 
-AssetManager::AssetManager(Manager* Man) : manager(Man){
+#include <SDL_image.h>
+AssetManager::AssetManager(Manager* Man) : manager(Man), projectilePool(Man, PROJECTILE_POOL_HIGH_WATER){
 
 }
 
@@ -10,23 +13,17 @@ AssetManager::~AssetManager(){
 
 }
 void AssetManager::CreateProjectile(Vector2D pos, Vector2D vel, int damage, int size, std::string id, int pierce) { 
-    auto& projectile(manager->addEntity());
-    projectile.addComponent<TransformComponent>(pos.x, pos.y, size, size, 1);
-    projectile.addComponent<SpriteComponent>(id);
-
-    projectile.addComponent<ProjectileComponent>(damage, vel, pierce);
+    auto& projectile(projectilePool.acquire(pos, vel, damage, size, id, pierce));
      if (id == "boss_projectile") { 
          if (projectile.hasComponent<ProjectileComponent>()) {
              projectile.getComponent<ProjectileComponent>().isSpinning = true; 
 
          }
      }
-
-    projectile.addComponent<ColliderComponent>("projectile");
-    projectile.addGroup(Game::groupProjectiles);
 }
 
 void AssetManager::AddTexture(std::string id, const char* path){
+    if (!Game::renderer) return;
 
     SDL_Texture* loadedTexture = TextureManager::LoadTexture(path);
     if (loadedTexture == nullptr) {
@@ -37,10 +34,52 @@ void AssetManager::AddTexture(std::string id, const char* path){
     }
 }
 
-SDL_Texture* AssetManager::GetTexture(std::string id){
-    return textures[id];
+void AssetManager::AddAtlasTexture(std::string id, const char* path){
+    if (!Game::renderer || !path) return;
+    pendingAtlasImages.emplace_back(id, path);
+}
+
+void AssetManager::BuildAtlas(){
+    if (!Game::renderer) return;
+
+    std::vector<SDL_Surface*> surfaces(pendingAtlasImages.size(), nullptr);
+    std::vector<std::string> errors(pendingAtlasImages.size());
+    JobSystem::shared().parallelFor(pendingAtlasImages.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            surfaces[i] = IMG_Load(pendingAtlasImages[i].second.c_str());
+            // SDL keeps the error per thread, so read it here.
+            if (!surfaces[i]) errors[i] = IMG_GetError();
+        }
+    });
+
+    // Added in queue order so the packed layout doesn't depend on decode timing.
+    for (std::size_t i = 0; i < pendingAtlasImages.size(); ++i) {
+        if (!surfaces[i]) {
+            std::cerr << "ERROR: AssetManager failed to load texture for ID: '" << pendingAtlasImages[i].first << "' path: " << pendingAtlasImages[i].second << ". IMG_Error: " << errors[i] << std::endl;
+            continue;
+        }
+        atlas.add(pendingAtlasImages[i].first, surfaces[i]);
+    }
+    pendingAtlasImages.clear();
+
+    if (!atlas.build(Game::renderer, TEXTURE_ATLAS_PAGE_SIZE)) {
+        std::cerr << "ERROR: AssetManager failed to build one or more texture atlas pages." << std::endl;
+    }
+}
+
+TextureRegion AssetManager::GetTexture(std::string id){
+    TextureRegion region;
+    if (atlas.find(id, region)) return region;
+
+    auto it = textures.find(id);
+    if (it != textures.end() && it->second) {
+        region.texture = it->second;
+        SDL_QueryTexture(region.texture, NULL, NULL, &region.rect.w, &region.rect.h);
+    }
+    return region;
 }
 void AssetManager::AddSoundEffect(std::string id, const char* path) {
+    if (!Game::audioEnabled) return;
     Mix_Chunk* sound = Mix_LoadWAV(path);
     if (sound == nullptr) {
         std::cerr << "Failed to load sound effect: " << path << "! SDL_mixer Error: " << Mix_GetError() << std::endl;
@@ -58,6 +97,7 @@ Mix_Chunk* AssetManager::GetSoundEffect(std::string id) {
 }
 
 void AssetManager::AddMusic(std::string id, const char* path) {
+    if (!Game::audioEnabled) return;
     Mix_Music* music = Mix_LoadMUS(path);
     if (music == nullptr) {
 
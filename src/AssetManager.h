@@ -1,9 +1,13 @@
 #pragma once
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 #include "TextureManager.h"
+#include "TextureAtlas.h"
 #include "Vector2D.h"
 #include "ECS/ECS.h"
+#include "ProjectilePool.h"
 #include <SDL_mixer.h>
 
 class AssetManager {
@@ -14,16 +18,26 @@ class AssetManager {
         void CreateProjectile(Vector2D pos, Vector2D vel,  int damage, int size, std::string id, int pierce = 1); 
 
         void AddTexture(std::string id, const char* path);
-        SDL_Texture* GetTexture(std::string id);
+        // Queued for the shared atlas; not drawable until BuildAtlas() runs.
+        void AddAtlasTexture(std::string id, const char* path);
+        // Decodes the queued images on the JobSystem, then packs and uploads
+        // them on this thread, since SDL textures must be made on the render thread.
+        void BuildAtlas();
+        TextureRegion GetTexture(std::string id);
 
         void AddSoundEffect(std::string id, const char* path);
         Mix_Chunk* GetSoundEffect(std::string id);
 
         void AddMusic(std::string id, const char* path);
         Mix_Music* GetMusic(std::string id);
+
+        ProjectilePool& GetProjectilePool() { return projectilePool; }
     private:
         Manager* manager;
+        ProjectilePool projectilePool;
         std::map<std::string, SDL_Texture*> textures;
+        TextureAtlas atlas;
+        std::vector<std::pair<std::string, std::string>> pendingAtlasImages;
         std::map<std::string, Mix_Chunk*> soundEffects; 
         std::map<std::string, Mix_Music*> musicTracks;  
     };
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "CrowdSteering.h"
+#include "JobSystem.h"
+#include "constants.h"
+#include "ECS/Components.h"
+#include "ECS/EnemyAi.h"
+#include <cmath>
+
+CrowdSteering::CrowdSteering() : grid(CROWD_GRID_CELL_SIZE) {}
+
+void CrowdSteering::reset(int worldWidth, int worldHeight) {
+    grid.reset(worldWidth, worldHeight);
+}
+
+void CrowdSteering::update(const std::vector<Entity*>& enemies) {
+    agents.clear();
+    grid.clear();
+    for (Entity* e : enemies) {
+        if (!e || !e->isActive() || !e->hasComponent<TransformComponent>() || !e->hasComponent<ColliderComponent>()) continue;
+
+        Agent agent;
+        agent.transform = &e->getComponent<TransformComponent>();
+        agent.collider = &e->getComponent<ColliderComponent>();
+        const SDL_Rect& col = agent.collider->collider;
+        agent.center = Vector2D(col.x + col.w / 2.0f, col.y + col.h / 2.0f);
+        if (e->hasComponent<EnemyAIComponent>()) {
+            agent.maxSpeed = e->getComponent<EnemyAIComponent>().getSpeed();
+            agent.steered = true;
+        }
+
+        SDL_Rect point = {static_cast<int>(agent.center.x), static_cast<int>(agent.center.y), 0, 0};
+        grid.insert(static_cast<int>(agents.size()), point);
+        agents.push_back(agent);
+    }
+
+    JobSystem& jobs = JobSystem::shared();
+    neighborScratch.resize(jobs.getSlotCount());
+    jobs.parallelFor(agents.size(), CROWD_JOB_GRAIN, [this](std::size_t begin, std::size_t end) {
+        std::vector<int>& neighbors = neighborScratch[JobSystem::currentSlot()];
+        for (std::size_t i = begin; i < end; ++i) {
+            if (agents[i].steered) steer(agents[i], i, neighbors);
+        }
+    });
+}
+
+void CrowdSteering::steer(Agent& self, std::size_t i, std::vector<int>& neighbors) const {
+    const float radius = static_cast<float>(CROWD_SEPARATION_RADIUS);
+    const float radiusSq = radius * radius;
+    SDL_Rect area = {static_cast<int>(self.center.x - radius), static_cast<int>(self.center.y - radius),
+                     CROWD_SEPARATION_RADIUS * 2, CROWD_SEPARATION_RADIUS * 2};
+    // One extra candidate, since the query also finds self.
+    grid.queryPoints(area, neighbors, CROWD_MAX_NEIGHBORS + 1);
+
+    Vector2D push(0.0f, 0.0f);
+    for (int j : neighbors) {
+        if (static_cast<std::size_t>(j) == i) continue;
+        float dx = self.center.x - agents[j].center.x;
+        float dy = self.center.y - agents[j].center.y;
+        float distSq = dx * dx + dy * dy;
+        if (distSq >= radiusSq) continue;
+
+        if (distSq < 0.0001f) {
+            // Exactly stacked: split the pair along x by id so they don't stay fused.
+            push.x += static_cast<std::size_t>(j) < i ? 1.0f : -1.0f;
+        } else {
+            float dist = std::sqrt(distSq);
+            float weight = (1.0f - dist / radius) / dist;
+            push.x += dx * weight;
+            push.y += dy * weight;
+        }
+    }
+
+    Vector2D velocity = self.transform->velocity;
+    velocity.x += push.x * self.maxSpeed * CROWD_SEPARATION_WEIGHT;
+    velocity.y += push.y * self.maxSpeed * CROWD_SEPARATION_WEIGHT;
+    float speedSq = velocity.x * velocity.x + velocity.y * velocity.y;
+    if (speedSq > self.maxSpeed * self.maxSpeed) {
+        float scale = self.maxSpeed / std::sqrt(speedSq);
+        velocity.x *= scale;
+        velocity.y *= scale;
+    }
+    self.transform->velocity = velocity;
+
+    // Moving here is safe: neighbours read the snapshot in agents, never the transforms.
+    self.transform->position.x += velocity.x;
+    self.transform->position.y += velocity.y;
+    self.collider->update();
+}
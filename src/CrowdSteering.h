@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+#include "UniformGrid.h"
+#include "Vector2D.h"
+
+class Entity;
+class TransformComponent;
+class ColliderComponent;
+
+// Keeps enemies from stacking on top of each other. EnemyAIComponent only
+// chooses a desired velocity; this pass then runs once over the whole enemy
+// group, adds a separation push from nearby enemies, caps the result at each
+// enemy's own speed and moves it.
+//
+// Every enemy reads the same snapshot of positions taken at the start of the
+// pass, and neighbours come back from the grid in a fixed order, so the
+// outcome doesn't depend on which enemy is processed first. That also lets the pass
+// run in parallel chunks on the JobSystem.
+class CrowdSteering {
+public:
+    CrowdSteering();
+
+    // Sizes the neighbour grid to cover the world.
+    void reset(int worldWidth, int worldHeight);
+    void update(const std::vector<Entity*>& enemies);
+
+private:
+    struct Agent {
+        TransformComponent* transform = nullptr;
+        ColliderComponent* collider = nullptr;
+        Vector2D center;
+        float maxSpeed = 0.0f;
+        // Bosses steer themselves; they only push others away.
+        bool steered = false;
+    };
+
+    UniformGrid grid;
+    std::vector<Agent> agents;
+    // One neighbour list per JobSystem slot.
+    std::vector<std::vector<int>> neighborScratch;
+
+    void steer(Agent& self, std::size_t index, std::vector<int>& neighbors) const;
+};
@@ -6,6 +6,7 @@
 #include "../Collision.h"
 #include "../constants.h"
 #include "../game.h"
+#include "../map.h"
 #include "BossAIComponent.h"
 #include "Components.h"
 #include "Player.h"
@@ -89,7 +90,7 @@ void BossAIComponent::init() {
     currentBurstCount = baseBurstCount;
     updateAttackScaling();
 
-    projectileAttackTimer = SDL_GetTicks() + projectileAttackInterval;
+    projectileAttackTimer = Game::getTicks() + projectileAttackInterval;
     slamCooldownEndTime = 0;
 
     changeState(BossState::WALKING);
@@ -103,11 +104,11 @@ void BossAIComponent::update() {
         return;
     }
 
-    if (SDL_GetTicks() % 1000 < 20) {
+    if (Game::getTicks() % 1000 < 20) {
         updateAttackScaling();
     }
 
-    Uint32 currentTime = SDL_GetTicks();
+    Uint32 currentTime = Game::getTicks();
 
     bool canShoot = (currentState != BossState::PRE_CHARGE &&
                      currentState != BossState::CHARGING &&
@@ -160,7 +161,7 @@ void BossAIComponent::changeState(BossState newState) {
     if (!sprite || !transform) return;
 
     currentState = newState;
-    stateTimer = SDL_GetTicks();
+    stateTimer = Game::getTicks();
 
     switch (newState) {
         case BossState::WALKING:
@@ -216,7 +217,7 @@ void BossAIComponent::updateWalking() {
         !playerEntity->hasComponent<ColliderComponent>())
         return;
 
-    Uint32 currentTime = SDL_GetTicks();
+    Uint32 currentTime = Game::getTicks();
     bool slamReady = currentTime >= slamCooldownEndTime;
 
     Vector2D playerColliderCenter = getPlayerColliderCenter(playerEntity);
@@ -239,8 +240,7 @@ void BossAIComponent::updateWalking() {
         transform->velocity.Zero();
     }
 
-    if (sprite->getTexture() !=
-        Game::instance->assets->GetTexture("boss_walk")) {
+    if (sprite->getTextureId() != "boss_walk") {
         sprite->setTex("boss_walk");
     }
     sprite->Play("Walk");
@@ -261,7 +261,7 @@ void BossAIComponent::updatePreCharge() {
     else if (faceDirection.x > 0)
         sprite->spriteFlip = SDL_FLIP_NONE;
 
-    if (SDL_GetTicks() >= stateTimer + preChargeDuration) {
+    if (Game::getTicks() >= stateTimer + preChargeDuration) {
         changeState(BossState::CHARGING);
     }
 }
@@ -277,14 +277,14 @@ void BossAIComponent::updateCharging() {
     else if (faceDirection.x > 0)
         sprite->spriteFlip = SDL_FLIP_NONE;
 
-    if (SDL_GetTicks() >= stateTimer + chargeDuration) {
+    if (Game::getTicks() >= stateTimer + chargeDuration) {
         shootProjectile();
         changeState(BossState::SHOOTING_BURST);
     }
 }
 
 void BossAIComponent::updateShootingBurst() {
-    Uint32 currentTime = SDL_GetTicks();
+    Uint32 currentTime = Game::getTicks();
     if (burstShotsRemaining > 0) {
         if (currentTime >= nextBurstShotTime) {
             shootSingleBurstProjectile();
@@ -301,7 +301,7 @@ void BossAIComponent::updateShootingBurst() {
 }
 
 void BossAIComponent::updateProjectileCooldown() {
-    if (SDL_GetTicks() >= stateTimer + projectileCooldownDuration) {
+    if (Game::getTicks() >= stateTimer + projectileCooldownDuration) {
         changeState(BossState::WALKING);
     }
 }
@@ -317,14 +317,14 @@ void BossAIComponent::updatePreSlam() {
     else if (faceDirection.x > 0)
         sprite->spriteFlip = SDL_FLIP_NONE;
 
-    if (SDL_GetTicks() >= stateTimer + 100) {
+    if (Game::getTicks() >= stateTimer + 100) {
         performSlam();
         changeState(BossState::SLAMMING);
     }
 }
 
 void BossAIComponent::updateSlamming() {
-    if (SDL_GetTicks() >= stateTimer + slamDuration) {
+    if (Game::getTicks() >= stateTimer + slamDuration) {
         changeState(BossState::WALKING);
     }
 }
@@ -332,7 +332,7 @@ void BossAIComponent::updateSlamming() {
 void BossAIComponent::shootProjectile() {
     if (!initialized || !transform) return;
     burstShotsRemaining = currentBurstCount;
-    nextBurstShotTime = SDL_GetTicks();
+    nextBurstShotTime = Game::getTicks();
 }
 
 void BossAIComponent::shootSingleBurstProjectile() {
@@ -391,12 +391,12 @@ void BossAIComponent::performSlam() {
 
     if (playerEntity->hasComponent<SpriteComponent>()) {
         playerEntity->getComponent<SpriteComponent>().isHit = true;
-        playerEntity->getComponent<SpriteComponent>().hitTime = SDL_GetTicks();
+        playerEntity->getComponent<SpriteComponent>().hitTime = Game::getTicks();
     }
 
     applyKnockback();
 
-    slamCooldownEndTime = SDL_GetTicks() + 1500;
+    slamCooldownEndTime = Game::getTicks() + 1500;
 }
 
 void BossAIComponent::applyKnockback() {
@@ -432,21 +432,8 @@ void BossAIComponent::applyKnockback() {
     bool collisionDetected = false;
 
     if (Game::instance) {
-        for (auto* terrainEntity :
-             Game::instance->manager.getGroup(Game::groupColliders)) {
-            if (terrainEntity && terrainEntity->isActive() &&
-                terrainEntity->hasComponent<ColliderComponent>()) {
-                ColliderComponent& terrainColliderComp =
-                    terrainEntity->getComponent<ColliderComponent>();
-                if (terrainColliderComp.tag == "terrain") {
-                    if (Collision::AABB(knockedBackPlayerRect,
-                                        terrainColliderComp.collider)) {
-                        collisionDetected = true;
-                        break;
-                    }
-                }
-            }
-        }
+        Map* map = Game::instance->getMap();
+        collisionDetected = map && map->overlapsSolid(knockedBackPlayerRect);
     } else {
         std::cerr << "Warning: Game::instance is null in "
                      "BossAIComponent::applyKnockback. Cannot check terrain "
@@ -90,6 +90,12 @@ class ColliderComponent : public Component {
         initialized = true;
     }
 
+    void resetSize(int cWidth = 0, int cHeight = 0) {
+        colliderWidth = cWidth;
+        colliderHeight = cHeight;
+        init();
+    }
+
     void update() override {
         if (!initialized) return;
 
@@ -141,6 +147,6 @@ class ColliderComponent : public Component {
 
         SDL_SetRenderDrawColor(Game::renderer, 255, 0, 0, 150);
 
-        SDL_RenderDrawRect(Game::renderer, &destR);
+        TextureManager::DrawRect(Game::renderer, &destR);
     }
 };
\ No newline at end of file
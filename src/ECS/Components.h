@@ -5,7 +5,6 @@
 #include "SpriteComponent.h"
 #include "KeyboardController.h"
 #include "ColliderComponent.h"
-#include "TileComponent.h"
 #include "ProjectileComponent.h"
 #include "HealthComponent.h"
 #include "WeaponComponent.h"
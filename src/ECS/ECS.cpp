@@ -2,10 +2,23 @@
 
 void Entity::addGroup(Group mGroup) {
     if (mGroup < maxGroups) { 
+        if (groupBitset[mGroup]) return;
         groupBitset[mGroup] = true;
         manager.AddToGroup(this, mGroup); 
     } else {
 
         std::cerr << "Error: Attempted to add entity to invalid group index: " << mGroup << std::endl;
     }
+}
+
+void Entity::delGroup(Group mGroup) {
+    if (mGroup >= maxGroups || !groupBitset[mGroup]) return;
+    groupBitset[mGroup] = false;
+    manager.RemoveFromGroup(this, mGroup);
+}
+
+void Entity::destroy() {
+    if (!active || isDestroyed) return;
+    active = false;
+    manager.markForRemoval(this);
 }
\ No newline at end of file
@@ -3,8 +3,10 @@
 #include <algorithm>
 #include <array>
 #include <bitset>
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <new>
 #include <vector>
 
 class Component;
@@ -26,6 +28,28 @@ inline ComponentID getComponentTypeID() noexcept {
     return typeID;
 }
 
+// 32-bit weak reference to an entity: the low bits pick a slot in the
+// Manager, the high bits must match that slot's generation. A recycled slot
+// gets a new generation, so stale handles resolve to nullptr.
+struct EntityHandle {
+    static constexpr std::uint32_t indexBits = 20;
+    static constexpr std::uint32_t indexMask = (1u << indexBits) - 1;
+    static constexpr std::uint32_t generationMask = (1u << (32 - indexBits)) - 1;
+
+    std::uint32_t value = 0;
+
+    static EntityHandle make(std::uint32_t index, std::uint32_t generation) {
+        return EntityHandle{(generation << indexBits) | (index & indexMask)};
+    }
+
+    std::uint32_t index() const { return value & indexMask; }
+    std::uint32_t generation() const { return value >> indexBits; }
+    bool isNull() const { return value == 0; }
+
+    bool operator==(const EntityHandle& other) const { return value == other.value; }
+    bool operator!=(const EntityHandle& other) const { return value != other.value; }
+};
+
 constexpr std::size_t maxComponents = 32;
 constexpr std::size_t maxGroups = 32;
 
@@ -44,20 +68,88 @@ class Component {
     virtual ~Component() {}
 };
 
+class ComponentPoolBase {
+   public:
+    virtual ~ComponentPoolBase() {}
+    virtual void release(Component* c) = 0;
+};
+
+// Components of one type live side by side in fixed blocks that never move,
+// so the raw pointers components keep to each other stay valid.
+template <typename T>
+class ComponentPool : public ComponentPoolBase {
+   private:
+    static constexpr std::size_t blockSize = 256;
+
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> blocks;
+    std::vector<T*> freeList;
+
+    void grow() {
+        blocks.emplace_back(new Slot[blockSize]);
+        Slot* block = blocks.back().get();
+        for (std::size_t i = blockSize; i-- > 0;) {
+            freeList.push_back(reinterpret_cast<T*>(block[i].storage));
+        }
+    }
+
+   public:
+    template <typename... TArgs>
+    T* create(TArgs&&... mArgs) {
+        if (freeList.empty()) grow();
+        T* c = new (freeList.back()) T(std::forward<TArgs>(mArgs)...);
+        freeList.pop_back();
+        return c;
+    }
+
+    void release(Component* c) override {
+        T* t = static_cast<T*>(c);
+        t->~T();
+        freeList.push_back(t);
+    }
+
+    std::size_t capacity() const { return blocks.size() * blockSize; }
+    std::size_t size() const { return capacity() - freeList.size(); }
+};
+
+struct ComponentDeleter {
+    ComponentPoolBase* pool = nullptr;
+    void operator()(Component* c) const { pool->release(c); }
+};
+
+using ComponentPtr = std::unique_ptr<Component, ComponentDeleter>;
+
+// Lets a pool take a destroyed entity back during Manager::refresh instead of
+// having it erased. Returning true parks the entity, components and all.
+class EntityRecycler {
+   public:
+    virtual ~EntityRecycler() {}
+    virtual bool recycle(Entity& mEntity) = 0;
+};
+
 class Entity {
+    friend class Manager;
+
    private:
     Manager& manager;
     bool active = true;
-    std::vector<std::unique_ptr<Component>> components;
+    std::vector<ComponentPtr> components;
 
     ComponentArray componentArray;
     ComponentBitSet componentBitSet;
     GroupBitset groupBitset;
+    std::array<std::size_t, maxGroups> groupIndex;
+    EntityHandle handle;
+    EntityRecycler* recycler = nullptr;
+    bool parked = false;
 
    public:
     Entity(Manager& mManager) : manager(mManager) {}
     bool isDestroyed = false;
-    const std::vector<std::unique_ptr<Component>>& getAllComponents() const {
+    const std::vector<ComponentPtr>& getAllComponents() const {
         return components;
     }
     void update() {
@@ -67,37 +159,28 @@ class Entity {
         for (auto& c : components) c->draw();
     }
     bool isActive() const { return active; }
-    void destroy() {
-        if (!isDestroyed) {
-            active = false;
-
-        } else {
-        }
-    }
+    bool isParked() const { return parked; }
+    void setRecycler(EntityRecycler* mRecycler) { recycler = mRecycler; }
+    EntityHandle getHandle() const { return handle; }
+    Manager& getManager() const { return manager; }
+    void destroy();
 
-    bool hasGroup(Group mGroup) { return groupBitset[mGroup]; }
+    bool hasGroup(Group mGroup) const { return groupBitset[mGroup]; }
     void addGroup(Group mGroup);
-    void delGroup(Group mGroup) { groupBitset[mGroup] = false; }
+    void delGroup(Group mGroup);
 
     template <typename T>
     bool hasComponent() const {
         return componentBitSet[getComponentTypeID<T>()];
     }
 
-    template <typename T, typename... TArgs>
-    T& addComponent(TArgs&&... mArgs) {
-        T* c(new T(std::forward<TArgs>(mArgs)...));
-        c->entity = this;
-        std::unique_ptr<Component> uPtr{c};
-        components.emplace_back(std::move(uPtr));
-
-        componentArray[getComponentTypeID<T>()] = c;
-        componentBitSet[getComponentTypeID<T>()] = true;
-
-        c->init();
-        return *c;
+    bool hasComponents(const ComponentBitSet& mask) const {
+        return (componentBitSet & mask) == mask;
     }
 
+    template <typename T, typename... TArgs>
+    T& addComponent(TArgs&&... mArgs);
+
     template <typename T>
     T& getComponent() const {
         auto ptr(componentArray[getComponentTypeID<T>()]);
@@ -106,63 +189,203 @@ class Entity {
 };
 class Manager {
    private:
+    std::array<std::unique_ptr<ComponentPoolBase>, maxComponents> componentPools;
     std::vector<std::unique_ptr<Entity>> entities;
     std::array<std::vector<Entity*>, maxGroups> groupedEntities;
+    std::array<std::uint32_t, maxGroups> groupVersions{};
+    std::vector<Entity*> pendingRemoval;
+
+    std::vector<Entity*> slotEntities;
+    std::vector<std::uint32_t> slotGenerations;
+    std::vector<std::uint32_t> freeSlots;
+
+    EntityHandle allocateSlot(Entity* mEntity) {
+        std::uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            if (slotEntities.size() > EntityHandle::indexMask) {
+                std::cerr << "Error: Entity slot table full, handle will be null." << std::endl;
+                return EntityHandle{};
+            }
+            index = static_cast<std::uint32_t>(slotEntities.size());
+            slotEntities.push_back(nullptr);
+            slotGenerations.push_back(1);
+        }
+        slotEntities[index] = mEntity;
+        return EntityHandle::make(index, slotGenerations[index]);
+    }
+
+    void releaseSlot(EntityHandle mHandle) {
+        if (mHandle.isNull()) return;
+        std::uint32_t index = mHandle.index();
+        slotEntities[index] = nullptr;
+        std::uint32_t generation = (slotGenerations[index] + 1) & EntityHandle::generationMask;
+        slotGenerations[index] = generation == 0 ? 1 : generation;
+        freeSlots.push_back(index);
+    }
 
    public:
     void update() {
         for (auto& e : entities) {
-            if (e) {
+            if (e && !e->parked) {
                 e->update();
             }
         }
     }
     void draw() {
         for (auto& e : entities) {
-            if (e) {
+            if (e && !e->parked) {
                 e->draw();
             }
         }
     }
 
+    // Group vectors are kept up to date by addGroup/delGroup, so refresh only
+    // has work to do when something was destroyed since the last call.
     void refresh() {
+        if (pendingRemoval.empty()) return;
+
+        for (Entity* e : pendingRemoval) {
+            for (Group group = 0; group < maxGroups; ++group) {
+                if (e->hasGroup(group)) e->delGroup(group);
+            }
+            releaseSlot(e->handle);
+            e->handle = EntityHandle{};
+            if (e->recycler && e->recycler->recycle(*e)) e->parked = true;
+        }
+        pendingRemoval.clear();
+
         entities.erase(
             std::remove_if(std::begin(entities), std::end(entities),
                            [](const std::unique_ptr<Entity>& mEntity) {
-                               return !mEntity || !mEntity->isActive();
+                               return !mEntity || (!mEntity->isActive() && !mEntity->parked);
                            }),
             std::end(entities));
+    }
 
-        for (auto& v : groupedEntities) {
-            v.clear();
-        }
+    // Brings a parked entity back with a fresh handle. Its groups and
+    // component state are left for the recycler to set up again.
+    void reviveEntity(Entity& mEntity) {
+        if (!mEntity.parked) return;
+        mEntity.parked = false;
+        mEntity.active = true;
+        mEntity.handle = allocateSlot(&mEntity);
+    }
 
-        for (const auto& entityPtr : entities) {
-            if (entityPtr && entityPtr->isActive()) {
-                for (Group group = 0; group < maxGroups; ++group) {
-                    if (entityPtr->hasGroup(group)) {
-                        groupedEntities[group].push_back(entityPtr.get());
-                    }
-                }
-            }
+    // Called when a recycler goes away so refresh never calls into it again.
+    // Entities it had parked are handed back to the normal destroy path.
+    void detachRecycler(EntityRecycler* mRecycler) {
+        for (auto& e : entities) {
+            if (!e || e->recycler != mRecycler) continue;
+            e->recycler = nullptr;
+            e->parked = false;
         }
+        entities.erase(
+            std::remove_if(std::begin(entities), std::end(entities),
+                           [](const std::unique_ptr<Entity>& mEntity) {
+                               return !mEntity || (!mEntity->isActive() && !mEntity->parked &&
+                                                   mEntity->handle.isNull());
+                           }),
+            std::end(entities));
     }
 
     void AddToGroup(Entity* mEntity, Group mGroup) {
         auto& groupVec = groupedEntities[mGroup];
-        if (std::find(groupVec.begin(), groupVec.end(), mEntity) ==
-            groupVec.end()) {
-            groupVec.emplace_back(mEntity);
+        mEntity->groupIndex[mGroup] = groupVec.size();
+        groupVec.emplace_back(mEntity);
+        ++groupVersions[mGroup];
+    }
+
+    void RemoveFromGroup(Entity* mEntity, Group mGroup) {
+        auto& groupVec = groupedEntities[mGroup];
+        std::size_t index = mEntity->groupIndex[mGroup];
+        if (index >= groupVec.size() || groupVec[index] != mEntity) return;
+
+        Entity* last = groupVec.back();
+        groupVec[index] = last;
+        last->groupIndex[mGroup] = index;
+        groupVec.pop_back();
+        ++groupVersions[mGroup];
+    }
+
+    void markForRemoval(Entity* mEntity) { pendingRemoval.push_back(mEntity); }
+
+    Entity* getEntity(EntityHandle mHandle) const {
+        if (mHandle.isNull()) return nullptr;
+        std::uint32_t index = mHandle.index();
+        if (index >= slotEntities.size() || slotGenerations[index] != mHandle.generation()) {
+            return nullptr;
         }
+        return slotEntities[index];
+    }
+
+    bool isValid(EntityHandle mHandle) const { return getEntity(mHandle) != nullptr; }
+
+    // Bumped only when a group's membership actually changes.
+    std::uint32_t getGroupVersion(Group mGroup) const {
+        return groupVersions[mGroup];
     }
+
     std::vector<Entity*>& getGroup(Group mGroup) {
         return groupedEntities[mGroup];
     }
 
+    template <typename... Ts>
+    static ComponentBitSet componentMask() {
+        ComponentBitSet mask;
+        (mask.set(getComponentTypeID<Ts>()), ...);
+        return mask;
+    }
+
+    // Calls fn(entity, Ts&...) for every active entity that has all of Ts.
+    // Entities added by fn are not visited until the next call.
+    template <typename... Ts, typename Fn>
+    void each(Fn&& fn) {
+        static const ComponentBitSet mask = componentMask<Ts...>();
+        const std::size_t count = entities.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            Entity* e = entities[i].get();
+            if (!e || !e->isActive() || !e->hasComponents(mask)) continue;
+            fn(*e, e->getComponent<Ts>()...);
+        }
+    }
+
+    std::size_t getActiveEntityCount() const {
+        std::size_t count = 0;
+        for (const auto& e : entities) {
+            if (e && e->active) ++count;
+        }
+        return count;
+    }
+
+    template <typename T>
+    ComponentPool<T>& getComponentPool() {
+        auto& pool = componentPools[getComponentTypeID<T>()];
+        if (!pool) pool.reset(new ComponentPool<T>());
+        return *static_cast<ComponentPool<T>*>(pool.get());
+    }
+
     Entity& addEntity() {
         Entity* e = new Entity(*this);
+        e->handle = allocateSlot(e);
         std::unique_ptr<Entity> uPtr{e};
         entities.emplace_back(std::move(uPtr));
         return *e;
     }
-};
\ No newline at end of file
+};
+
+template <typename T, typename... TArgs>
+T& Entity::addComponent(TArgs&&... mArgs) {
+    ComponentPool<T>& pool = manager.getComponentPool<T>();
+    T* c = pool.create(std::forward<TArgs>(mArgs)...);
+    c->entity = this;
+    components.emplace_back(c, ComponentDeleter{&pool});
+
+    componentArray[getComponentTypeID<T>()] = c;
+    componentBitSet[getComponentTypeID<T>()] = true;
+
+    c->init();
+    return *c;
+}
\ No newline at end of file
@@ -14,6 +14,18 @@ class ColliderComponent;
 class SpriteComponent;
 class HealthComponent;
 
+// What an enemy may read about the rest of the world while thinking. Resolved
+// once per tick on the main thread so think() never touches shared state.
+struct EnemyAIContext {
+    bool playerValid = false;
+    Vector2D playerPosition;
+    SDL_Rect playerCollider = {0, 0, 0, 0};
+    // Simulation camera; picks the LOD tier.
+    SDL_Rect view = {0, 0, 0, 0};
+    Uint32 currentTime = 0;
+    const FlowField* flowField = nullptr;
+};
+
 class EnemyAIComponent : public Component {
 private:
 
@@ -27,8 +39,10 @@ private:
 
     int contactDamage;
     int expValue;
-    Entity* playerEntity = nullptr;
-    Vector2D* playerPosition = nullptr; 
+    EntityHandle playerHandle;
+
+    int lodTier = 0;
+    int ticksUntilThink = 0;
 
     Uint32 lastDamageTime = 0;
     const Uint32 damageInterval = 1000; 
@@ -36,16 +50,17 @@ private:
 
 public:
 
-    EnemyAIComponent(int range, float moveSpeed, Vector2D* playerTransformPosPtr, int damage = 10, int exp = 1, Entity* player = nullptr)
+    EnemyAIComponent(int range, float moveSpeed, EntityHandle player, int damage = 10, int exp = 1)
         : detectionRange(range > 0 ? range : 100),
           speed(moveSpeed >= 0.0f ? moveSpeed : 1.0f), 
           contactDamage(damage > 0 ? damage : 1),
           expValue(exp >= 0 ? exp : 0),
-          playerEntity(player),
-          playerPosition(playerTransformPosPtr)
+          playerHandle(player)
           {}
 
     int getExpValue() const { return expValue; }
+    float getSpeed() const { return speed; }
+    int getLodTier() const { return lodTier; }
     void setExpValue(int value) { expValue = std::max(0, value); }
 
     void init() override {
@@ -63,49 +78,67 @@ public:
 
         if (!transform) { std::cerr << "Error in EnemyAIComponent::init: Failed to get transform pointer!" << std::endl; return; }
         if (!collider) { std::cerr << "Error in EnemyAIComponent::init: Failed to get collider pointer!" << std::endl; return; }
-        if (!playerPosition) { std::cerr << "Error in EnemyAIComponent::init: Player Position pointer is null!" << std::endl; return; }
-        if (!playerEntity) { std::cerr << "Error in EnemyAIComponent::init: Player Entity pointer is null!" << std::endl; return; }
+        if (playerHandle.isNull()) { std::cerr << "Error in EnemyAIComponent::init: Player handle is null!" << std::endl; return; }
 
         detectionRect.w = collider->collider.w + detectionRange * 2;
         detectionRect.h = collider->collider.h + detectionRange * 2;
 
+        lodTier = 0;
+        ticksUntilThink = 0;
         initialized = true;
     }
 
-    void update() override {
-        if (!initialized || !transform || !collider || !playerPosition || !playerEntity) return;
+    // Not driven by Manager::update: Game runs think() for all enemies in
+    // parallel and applies the returned contact damage afterwards, in group
+    // order. Only this enemy's own components are written here.
+    int think(const EnemyAIContext& context) {
+        if (!initialized || !transform || !collider) return 0;
+        // Between thinking ticks the last velocity carries the enemy on.
+        if (ticksUntilThink > 0) {
+            --ticksUntilThink;
+            return 0;
+        }
 
-        if (!playerEntity->isActive() || !playerEntity->hasComponent<ColliderComponent>() || !playerEntity->hasComponent<HealthComponent>() || !playerEntity->hasComponent<TransformComponent>()) {
+        if (!context.playerValid) {
             transform->velocity.Zero();
-            return;
+            return 0;
         }
 
-        Vector2D playerActualPos = playerEntity->getComponent<TransformComponent>().position;
-        SDL_Rect playerColRect = playerEntity->getComponent<ColliderComponent>().collider;
+        Vector2D playerActualPos = context.playerPosition;
+        SDL_Rect playerColRect = context.playerCollider;
+
+        const SDL_Rect& view = context.view;
+        SDL_Rect nearView = {view.x - AI_LOD_NEAR_MARGIN, view.y - AI_LOD_NEAR_MARGIN, view.w + 2 * AI_LOD_NEAR_MARGIN, view.h + 2 * AI_LOD_NEAR_MARGIN};
+        SDL_Rect midView = {view.x - AI_LOD_MID_MARGIN, view.y - AI_LOD_MID_MARGIN, view.w + 2 * AI_LOD_MID_MARGIN, view.h + 2 * AI_LOD_MID_MARGIN};
+        if (SDL_HasIntersection(&collider->collider, &nearView)) { lodTier = 0; ticksUntilThink = AI_LOD_NEAR_INTERVAL - 1; }
+        else if (SDL_HasIntersection(&collider->collider, &midView)) { lodTier = 1; ticksUntilThink = AI_LOD_MID_INTERVAL - 1; }
+        else { lodTier = 2; ticksUntilThink = AI_LOD_FAR_INTERVAL - 1; }
 
         detectionRect.x = collider->collider.x - detectionRange;
         detectionRect.y = collider->collider.y - detectionRange;
 
+        int damageDealt = 0;
         if (Collision::AABB(collider->collider, playerColRect)) {
-            Uint32 currentTime = SDL_GetTicks();
-            if (currentTime >= lastDamageTime + damageInterval) {
-                playerEntity->getComponent<HealthComponent>().takeDamage(contactDamage);
-                lastDamageTime = currentTime;
-                 if (playerEntity->hasComponent<SpriteComponent>()) {
-                     playerEntity->getComponent<SpriteComponent>().isHit = true;
-                     playerEntity->getComponent<SpriteComponent>().hitTime = currentTime;
-                 }
+            if (context.currentTime >= lastDamageTime + damageInterval) {
+                damageDealt = contactDamage;
+                lastDamageTime = context.currentTime;
             }
         }
 
         if (Collision::AABB(playerColRect, detectionRect)) {
 
-            Vector2D direction = playerActualPos - transform->position;
-
-            if (direction.x != 0.0f || direction.y != 0.0f) {
-                 direction = direction.Normalize();
-            } else {
-                direction.Zero(); 
+            // Follow the shared flow field around terrain; once in the player's tile
+            // (or off the field entirely) head straight for them.
+            Vector2D direction;
+            Vector2D center(collider->collider.x + collider->collider.w / 2.0f, collider->collider.y + collider->collider.h / 2.0f);
+            if (!context.flowField || !context.flowField->getDirection(center, direction)) {
+                direction = playerActualPos - transform->position;
+
+                if (direction.x != 0.0f || direction.y != 0.0f) {
+                     direction = direction.Normalize();
+                } else {
+                    direction.Zero(); 
+                }
             }
             transform->velocity = direction * speed;
 
@@ -120,10 +153,8 @@ public:
 
             transform->velocity.Zero();
         }
-
-        transform->position.x += transform->velocity.x;
-        transform->position.y += transform->velocity.y;
-
+        // The move itself happens in CrowdSteering, once separation has been applied.
+        return damageDealt;
     }
 
     void draw() override {
@@ -138,7 +169,7 @@ public:
             detectionRect.w,
             detectionRect.h
         };
-        SDL_RenderDrawRect(Game::renderer, &debugDetectionRect);
+        TextureManager::DrawRect(Game::renderer, &debugDetectionRect);
     }
 
     int getContactDamage() const { return contactDamage; }
@@ -1,5 +1,4 @@
 #include <iostream>
-#include <stdexcept>
 
 #include "../Collision.h"
 #include "../game.h"
@@ -48,33 +47,16 @@ void ExpOrbComponent::init() {
     initialized = true;
 }
 
-void ExpOrbComponent::update() {
-    if (!initialized || collected) return;
-
-    if (!collider || !Game::instance) return;
-
-    Player* playerManager = Game::instance->getPlayerManager();
-    if (!playerManager) return;
-
-    Entity* playerEntityPtr = nullptr;
-    try {
-        playerEntityPtr = &playerManager->getEntity();
-    } catch (const std::runtime_error& e) {
-        std::cerr << "ExpOrbComponent::update Error: " << e.what() << std::endl;
-        return;
-    }
-
-    if (playerEntityPtr && playerEntityPtr->isActive() &&
-        playerEntityPtr->hasComponent<ColliderComponent>()) {
-        auto& playerCollider =
-            playerEntityPtr->getComponent<ColliderComponent>();
+bool ExpOrbComponent::touches(const SDL_Rect& playerCollider) const {
+    if (!initialized || collected || !collider) return false;
+    return Collision::AABB(collider->collider, playerCollider);
+}
 
-        if (Collision::AABB(collider->collider, playerCollider.collider)) {
-            playerManager->addExperience(experienceAmount);
-            collected = true;
-            if (entity) {
-                entity->destroy();
-            }
-        }
+void ExpOrbComponent::collect(Player& playerManager) {
+    if (collected) return;
+    playerManager.addExperience(experienceAmount);
+    collected = true;
+    if (entity) {
+        entity->destroy();
     }
-}
\ No newline at end of file
+}
@@ -3,6 +3,8 @@
 #include "Components.h"  
 #include "ECS.h"
 
+class Player;
+
 class ExpOrbComponent : public Component {
    private:
 
@@ -20,6 +22,9 @@ class ExpOrbComponent : public Component {
     ExpOrbComponent(int exp) : experienceAmount(exp) {}
 
     void init() override;
-    void update() override;
+    // Pickup is split so Game can test every orb in parallel and then
+    // collect the touching ones on the main thread, in group order.
+    bool touches(const SDL_Rect& playerCollider) const;
+    void collect(Player& playerManager);
 
 };  
\ No newline at end of file
@@ -73,7 +73,7 @@ class KeyboardController : public Component {
     void update() override {
         if (!initialized || !transform) return;
 
-        const Uint8* keystate = SDL_GetKeyboardState(NULL);
+        const Uint8* keystate = Game::getKeyboardState();
         Vector2D desiredVelocity;
 
         if (keystate[SDL_SCANCODE_W]) desiredVelocity.y = -1;
@@ -2,10 +2,12 @@
 
 #include <cmath>
 #include <iostream>
-#include <set>
+#include <algorithm>
+#include <vector>
 
 #include "../Vector2D.h"
 #include "../game.h"
+#include "ColliderComponent.h"
 #include "Components.h"
 #include "ECS.h"
 
@@ -18,7 +20,7 @@ class ProjectileComponent : public Component {
     int damage = 0;
     Vector2D velocity;
     int maxPierce = 1;
-    std::set<Entity*> hitEnemies;
+    std::vector<EntityHandle> hitEnemies;
     bool initialized = false;
 
    public:
@@ -56,37 +58,55 @@ class ProjectileComponent : public Component {
         initialized = true;
     }
 
-    void update() override {
-        if (!initialized || !transform) {
-            if (entity) entity->destroy();
-            return;
-        }
+    // Driven by Game's parallel projectile pass rather than Manager::update.
+    // Only moves this projectile; returns false when it should be destroyed,
+    // which the caller does afterwards on the main thread.
+    bool advance(const SDL_Rect& camera) {
+        if (!initialized || !transform) return false;
 
         transform->position += velocity;
+        // Manager::update placed the collider before this move; bring it along
+        // so hits are tested where the projectile is now. It only writes this
+        // entity's own component, so it's safe in the parallel pass.
+        if (entity->hasComponent<ColliderComponent>()) {
+            entity->getComponent<ColliderComponent>().update();
+        }
 
-        if (transform->position.x > Game::camera.x + Game::camera.w + 100 ||
+        if (transform->position.x > camera.x + camera.w + 100 ||
             transform->position.x + transform->width * transform->scale <
-                Game::camera.x - 100 ||
-            transform->position.y > Game::camera.y + Game::camera.h + 100 ||
+                camera.x - 100 ||
+            transform->position.y > camera.y + camera.h + 100 ||
             transform->position.y + transform->height * transform->scale <
-                Game::camera.y - 100) {
-            if (entity) entity->destroy();
-            return;
+                camera.y - 100) {
+            return false;
         }
+        return true;
+    }
+
+    void reset(int dmg, Vector2D vel, int pierce = 1) {
+        damage = dmg;
+        velocity = vel;
+        maxPierce = pierce > 0 ? pierce : 1;
+        hitEnemies.clear();
+        isSpinning = false;
+        init();
     }
 
     int getDamage() const { return damage; }
 
-    bool hasHit(Entity* enemy) const { return hitEnemies.count(enemy) > 0; }
+    bool hasHit(Entity* enemy) const {
+        return enemy && std::find(hitEnemies.begin(), hitEnemies.end(),
+                                  enemy->getHandle()) != hitEnemies.end();
+    }
 
     void recordHit(Entity* enemy) {
-        if (enemy) {
-            hitEnemies.insert(enemy);
+        if (enemy && !hasHit(enemy)) {
+            hitEnemies.push_back(enemy->getHandle());
         }
     }
 
     bool shouldDestroy() const {
         return hitEnemies.size() >=
-               static_cast<std::set<Entity*>::size_type>(maxPierce);
+               static_cast<std::vector<EntityHandle>::size_type>(maxPierce);
     }
 };
\ No newline at end of file
@@ -41,7 +41,7 @@ class SoundComponent : public Component {
     }
 
     void playBackgroundMusic(int loops = -1) {
-        if (backgroundMusicID.empty()) {
+        if (backgroundMusicID.empty() || !Game::audioEnabled) {
 
             return;
         }
@@ -68,6 +68,7 @@ class SoundComponent : public Component {
 
     int playSoundEffect(const std::string& internalName, int loops = 0) {
         int channel = -1;
+        if (!Game::audioEnabled) return channel;
         if (!Game::instance || !Game::instance->assets) {
             std::cerr << "SoundComponent Error: Cannot play sound effect, Game "
                          "instance or AssetManager is null!"
@@ -103,7 +104,9 @@ class SoundComponent : public Component {
         return channel;
     }
 
-    void stopMusic() { Mix_HaltMusic(); }
+    void stopMusic() {
+        if (Game::audioEnabled) Mix_HaltMusic();
+    }
 
     void init() override {}
 
@@ -51,7 +51,7 @@ void SpellComponent::init() {
         sound = nullptr;
     }
 
-    lastCastTime = SDL_GetTicks();  
+    lastCastTime = Game::getTicks();  
     initialized = true;
 }
 
@@ -59,7 +59,7 @@ void SpellComponent::update() {
     if (!initialized || !transform)
         return;  
 
-    Uint32 currentTime = SDL_GetTicks();
+    Uint32 currentTime = Game::getTicks();
 
     if (burstShotsRemaining > 0) {
         if (currentTime >= nextBurstShotTime) {
@@ -137,8 +137,7 @@ void SpellComponent::castSingleProjectile() {
     Vector2D velocity;
 
     if (trajectoryMode == SpellTrajectory::RANDOM_DIRECTION) {
-        float randomAngle = static_cast<float>(rand()) /
-                            (static_cast<float>(RAND_MAX / (2.0 * PI)));
+        float randomAngle = Game::random.nextFloat() * static_cast<float>(2.0 * PI);
         velocity.x = std::cos(randomAngle) * projectileSpeed;
         velocity.y = std::sin(randomAngle) * projectileSpeed;
         createProjectile(spawnCenter, velocity);
@@ -176,8 +175,7 @@ void SpellComponent::castSpellFull() {
         default:  
             for (int i = 0; i < projectilesPerCast; ++i) {
 
-                float randomAngle = static_cast<float>(rand()) /
-                                    (static_cast<float>(RAND_MAX / (2.0 * PI)));
+                float randomAngle = Game::random.nextFloat() * static_cast<float>(2.0 * PI);
                 Vector2D defaultVel;
                 defaultVel.x = std::cos(randomAngle) * projectileSpeed;
                 defaultVel.y = std::sin(randomAngle) * projectileSpeed;
@@ -8,6 +8,7 @@
 
 #include "../AssetManager.h"
 #include "../TextureManager.h"
+#include "../constants.h"
 #include "../game.h"
 #include "Animation.h"
 #include "Components.h"
@@ -19,6 +20,9 @@ class SpriteComponent : public Component {
    private:
     TransformComponent* transform = nullptr;
     SDL_Texture* texture = nullptr;
+    std::string textureId;
+    // Where the sheet sits inside its (possibly shared atlas) texture; srcRect is relative to it.
+    SDL_Rect region = {0, 0, 0, 0};
     SDL_Rect srcRect = {0, 0, 0, 0};
     SDL_Rect destRect = {0, 0, 0, 0};
 
@@ -91,7 +95,7 @@ class SpriteComponent : public Component {
 
         if (animated && frames > 0 && speed > 0) {
             srcRect.x =
-                srcRect.w * static_cast<int>((SDL_GetTicks() / speed) % frames);
+                srcRect.w * static_cast<int>((Game::getTicks() / speed) % frames);
         } else if (!animated) {
             srcRect.x = 0;
         }
@@ -99,8 +103,6 @@ class SpriteComponent : public Component {
         srcRect.y =
             (transform->height > 0) ? (animIndex * transform->height) : 0;
 
-        destRect.x = static_cast<int>(transform->position.x - Game::camera.x);
-        destRect.y = static_cast<int>(transform->position.y - Game::camera.y);
         destRect.w = transform->width * transform->scale;
         destRect.h = transform->height * transform->scale;
 
@@ -110,8 +112,7 @@ class SpriteComponent : public Component {
         }
 
         if (shouldSpin) {
-            const float timeStep = 1.0f / 60.0f;
-            angle += rotationSpeed * timeStep;
+            angle += rotationSpeed * FIXED_TIMESTEP;
             if (angle >= 360.0) angle -= 360.0;
             if (angle < 0.0) angle += 360.0;
         } else {
@@ -122,9 +123,13 @@ class SpriteComponent : public Component {
     void draw() override {
         if (!initialized || !texture || !transform) return;
 
+        Vector2D renderPos = transform->getRenderPosition(Game::renderAlpha);
+        destRect.x = static_cast<int>(renderPos.x - Game::camera.x);
+        destRect.y = static_cast<int>(renderPos.y - Game::camera.y);
+
         SDL_Color currentTint = tint;
         if (isHit) {
-            if (SDL_GetTicks() > hitTime + hitDuration) {
+            if (Game::getTicks() > hitTime + hitDuration) {
                 isHit = false;
 
             } else {
@@ -132,16 +137,34 @@ class SpriteComponent : public Component {
             }
         }
 
+        // srcRect is sized from the transform and can run past the image (small
+        // orbs, grown projectiles). Clip it to the region like SDL_RenderCopy
+        // clips to a whole texture, or it reads the atlas neighbours' pixels.
+        SDL_Rect bounds = {0, 0, region.w, region.h};
+        SDL_Rect src;
+        if (!SDL_IntersectRect(&srcRect, &bounds, &src)) return;
+        src.x += region.x;
+        src.y += region.y;
+
+        if (Game::instance && Game::instance->spriteBatch.isOpen()) {
+            Game::instance->spriteBatch.add(texture, src, destRect, angle,
+                                            spriteFlip, currentTint);
+            return;
+        }
+
         SDL_SetTextureColorMod(texture, currentTint.r, currentTint.g,
                                currentTint.b);
-        TextureManager::Draw(texture, srcRect, destRect, angle, spriteFlip);
+        TextureManager::Draw(texture, src, destRect, angle, spriteFlip);
         SDL_SetTextureColorMod(texture, 255, 255, 255);
     }
 
     void setTex(std::string id) {
         if (Game::instance && Game::instance->assets) {
-            texture = Game::instance->assets->GetTexture(id);
-            if (!texture) {
+            TextureRegion found = Game::instance->assets->GetTexture(id);
+            texture = found.texture;
+            region = found.rect;
+            textureId = id;
+            if (!texture && Game::renderer) {
                 std::cerr << "Warning in SpriteComponent::setTex: Texture ID '"
                           << id << "' not found in AssetManager!" << std::endl;
             }
@@ -150,10 +173,24 @@ class SpriteComponent : public Component {
                          "Game::instance->assets is null!"
                       << std::endl;
             texture = nullptr;
+            region = {0, 0, 0, 0};
+            textureId = id;
         }
     }
 
+    void reset(std::string id) {
+        setTex(id);
+        tint = {255, 255, 255, 255};
+        spriteFlip = SDL_FLIP_NONE;
+        angle = 0.0;
+        isHit = false;
+        hitTime = 0;
+        init();
+    }
+
     SDL_Texture* getTexture() { return texture; }
+    // Sprites packed into one atlas share a texture, so compare ids instead.
+    const std::string& getTextureId() const { return textureId; }
 
     void Play(const char* animName) {
         auto it = animations.find(animName);
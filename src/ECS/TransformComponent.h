@@ -6,6 +6,7 @@
 struct TransformComponent : public Component {
    public:
     Vector2D position;
+    Vector2D previousPosition;
     Vector2D velocity;
 
     int height = 32;
@@ -30,10 +31,22 @@ struct TransformComponent : public Component {
         velocity.Zero();
     }
 
-    void init() override { velocity.Zero(); }
+    void init() override {
+        velocity.Zero();
+        resetInterpolation();
+    }
 
     void update() override {
+        previousPosition = position;
         position.x += velocity.x;
         position.y += velocity.y;
     }
+
+    // Call after teleporting so the next frame doesn't blend from the old spot.
+    void resetInterpolation() { previousPosition = position; }
+
+    Vector2D getRenderPosition(float alpha) const {
+        return Vector2D(previousPosition.x + (position.x - previousPosition.x) * alpha,
+                        previousPosition.y + (position.y - previousPosition.y) * alpha);
+    }
 };
\ No newline at end of file
@@ -68,7 +68,7 @@ void WeaponComponent::init() {
         return;
     }
 
-    lastShotTime = SDL_GetTicks();  
+    lastShotTime = Game::getTicks();  
     burstShotsRemaining = 0;
 
     initialized = true;
@@ -78,7 +78,7 @@ void WeaponComponent::update() {
     if (!initialized || !transform || !collider)
         return;  
 
-    Uint32 currentTime = SDL_GetTicks();
+    Uint32 currentTime = Game::getTicks();
 
     if (burstShotsRemaining > 0) {
         if (currentTime >= nextBurstShotTime) {
@@ -0,0 +1,127 @@
+#include "FlowField.h"
+#include "map.h"
+#include <algorithm>
+#include <climits>
+#include <functional>
+
+namespace {
+// Neighbour offsets; a tile's stored direction indexes this table. Diagonal
+// steps cost 14 against 10 for straight ones, close enough to sqrt(2).
+const int kStepX[8] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+const int kStepY[8] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+const int kStepCost[8] = { 10, 10, 10, 10, 14, 14, 14, 14 };
+const float kDiagonal = 0.70710678f;
+const std::int8_t kNoDirection = -1;
+}
+
+FlowField::FlowField(int budget) : tilesPerUpdate(budget > 0 ? budget : 4096) {}
+
+void FlowField::reset(const Map& map) {
+    width = map.getWidthInTiles();
+    height = map.getHeightInTiles();
+    tileSize = std::max(1, map.getScaledSize());
+
+    std::size_t count = static_cast<std::size_t>(std::max(0, width)) * std::max(0, height);
+    directions.assign(count, kNoDirection);
+    pendingCost.assign(count, INT_MAX);
+    pendingDirections.assign(count, kNoDirection);
+    frontier.clear();
+    touched.clear();
+    servedTouched.clear();
+    targetX = targetY = -1;
+    pendingTargetX = pendingTargetY = -1;
+    ready = false;
+    searching = false;
+}
+
+void FlowField::update(const Map& map, int tileX, int tileY) {
+    if (width <= 0 || height <= 0) return;
+    tileX = std::min(std::max(tileX, 0), width - 1);
+    tileY = std::min(std::max(tileY, 0), height - 1);
+
+    // Retargeting mid-search would throw away the work done so far, and a
+    // target that moves faster than the search would never get a field.
+    bool servedMatches = ready && tileX == targetX && tileY == targetY;
+    if (!searching && !servedMatches) startSearch(map, tileX, tileY);
+    if (searching) advanceSearch(map);
+}
+
+void FlowField::startSearch(const Map& map, int tileX, int tileY) {
+    // pendingDirections holds the field served before the last swap; clear
+    // just the tiles it set. pendingCost was cleared when that search finished.
+    for (int tile : touched) pendingDirections[tile] = kNoDirection;
+    touched.clear();
+    frontier.clear();
+    pendingTargetX = tileX;
+    pendingTargetY = tileY;
+    searching = true;
+
+    // A player standing on a solid tile (pushed there by knockback) has no
+    // walkable goal; keep serving the old field until they step off it.
+    if (map.isSolid(tileX, tileY)) {
+        searching = false;
+        return;
+    }
+    int goal = tileY * width + tileX;
+    pendingCost[goal] = 0;
+    touched.push_back(goal);
+    frontier.push_back({0, goal});
+}
+
+void FlowField::advanceSearch(const Map& map) {
+    // Min-heap on (cost, tile index); ties break on the index, so the result
+    // never depends on insertion order.
+    auto later = std::greater<std::pair<int, int>>();
+    int settled = 0;
+    while (!frontier.empty() && settled < tilesPerUpdate) {
+        std::pop_heap(frontier.begin(), frontier.end(), later);
+        std::pair<int, int> node = frontier.back();
+        frontier.pop_back();
+        if (node.first != pendingCost[node.second]) continue;
+        ++settled;
+
+        int x = node.second % width;
+        int y = node.second / width;
+        for (int d = 0; d < 8; ++d) {
+            int nx = x + kStepX[d];
+            int ny = y + kStepY[d];
+            if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+            if (map.isSolid(nx, ny)) continue;
+            // No cutting corners: both tiles beside a diagonal must be open.
+            if (d >= 4 && (map.isSolid(x, ny) || map.isSolid(nx, y))) continue;
+
+            int next = ny * width + nx;
+            int cost = node.first + kStepCost[d];
+            if (cost >= pendingCost[next]) continue;
+            if (pendingCost[next] == INT_MAX) touched.push_back(next);
+            pendingCost[next] = cost;
+            // The neighbour steps back the way the search came: the opposite offset.
+            pendingDirections[next] = static_cast<std::int8_t>(d < 4 ? (d + 2) % 4 : 4 + (d - 2) % 4);
+            frontier.push_back({cost, next});
+            std::push_heap(frontier.begin(), frontier.end(), later);
+        }
+    }
+
+    if (frontier.empty()) {
+        for (int tile : touched) pendingCost[tile] = INT_MAX;
+        directions.swap(pendingDirections);
+        touched.swap(servedTouched);
+        targetX = pendingTargetX;
+        targetY = pendingTargetY;
+        ready = true;
+        searching = false;
+    }
+}
+
+bool FlowField::getDirection(const Vector2D& worldPos, Vector2D& outDirection) const {
+    if (!ready || worldPos.x < 0.0f || worldPos.y < 0.0f) return false;
+    int tileX = static_cast<int>(worldPos.x) / tileSize;
+    int tileY = static_cast<int>(worldPos.y) / tileSize;
+    if (tileX >= width || tileY >= height) return false;
+
+    std::int8_t d = directions[static_cast<std::size_t>(tileY) * width + tileX];
+    if (d == kNoDirection) return false;
+    float scale = d < 4 ? 1.0f : kDiagonal;
+    outDirection = Vector2D(kStepX[d] * scale, kStepY[d] * scale);
+    return true;
+}
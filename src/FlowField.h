@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Vector2D.h"
+
+class Map;
+
+// Dijkstra map over the tile grid toward a single target tile (the player).
+// Every walkable tile stores the step to take toward the target, so any
+// number of enemies can steer around terrain with one lookup each.
+//
+// A search is advanced a bounded number of tiles per update and always runs
+// to completion; once it finishes, the next one starts from wherever the
+// target is by then. The last finished field keeps being served in between.
+// Only the tiles a search reached are cleared for the next one, so a target
+// that keeps moving on a big map costs the budget and nothing more. Work is
+// counted in tiles, not time, so replays settle the same field on the same tick.
+class FlowField {
+public:
+    explicit FlowField(int tilesPerUpdate = 4096);
+
+    // Sizes the field for the map and drops any finished or pending search.
+    void reset(const Map& map);
+    void update(const Map& map, int targetTileX, int targetTileY);
+
+    // Unit step toward the target for the tile under worldPos. False on the
+    // target tile itself, on solid or unreachable tiles, and before the first
+    // search finishes; callers should head straight for the target then.
+    bool getDirection(const Vector2D& worldPos, Vector2D& outDirection) const;
+    bool isReady() const { return ready; }
+
+private:
+    int tilesPerUpdate;
+    int width = 0;
+    int height = 0;
+    int tileSize = 1;
+
+    // Served field.
+    std::vector<std::int8_t> directions;
+    std::vector<int> servedTouched;
+    int targetX = -1;
+    int targetY = -1;
+    bool ready = false;
+
+    // Search in progress.
+    std::vector<int> pendingCost;
+    std::vector<std::int8_t> pendingDirections;
+    std::vector<std::pair<int, int>> frontier;
+    std::vector<int> touched;
+    int pendingTargetX = -1;
+    int pendingTargetY = -1;
+    bool searching = false;
+
+    void startSearch(const Map& map, int tileX, int tileY);
+    void advanceSearch(const Map& map);
+};
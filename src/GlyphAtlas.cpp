@@ -0,0 +1,155 @@
+#include "GlyphAtlas.h"
+#include "TextureManager.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    const int atlasMaxWidth = 512;
+    const int glyphPadding = 1;
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    destroy();
+}
+
+void GlyphAtlas::destroy() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+    vertices.clear();
+    indices.clear();
+}
+
+bool GlyphAtlas::build(SDL_Renderer* renderer, TTF_Font* font) {
+    destroy();
+    if (!renderer || !font) return false;
+
+    // Each glyph is rendered as a one-character string so its cell already has
+    // the bearing and baseline offset TTF_RenderText would give it in a line.
+    const SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* cells[glyphCount] = {};
+    int penX = 0, penY = 0, rowHeight = 0;
+    lineHeight = TTF_FontHeight(font);
+
+    for (int i = 0; i < glyphCount; ++i) {
+        Uint16 ch = static_cast<Uint16>(firstChar + i);
+        int minX = 0, maxX = 0, minY = 0, maxY = 0, advance = 0;
+        if (TTF_GlyphMetrics(font, ch, &minX, &maxX, &minY, &maxY, &advance) != 0) advance = 0;
+        glyphs[i].advance = advance;
+        // A negative left bearing on the first character shifts it right inside its cell.
+        glyphs[i].offsetX = std::min(0, minX);
+
+        char text[2] = {static_cast<char>(ch), '\0'};
+        if (ch != ' ') cells[i] = TTF_RenderText_Blended(font, text, white);
+        if (!cells[i]) continue;
+
+        if (penX + cells[i]->w > atlasMaxWidth) {
+            penX = 0;
+            penY += rowHeight + glyphPadding;
+            rowHeight = 0;
+        }
+        glyphs[i].src = {penX, penY, cells[i]->w, cells[i]->h};
+        penX += cells[i]->w + glyphPadding;
+        rowHeight = std::max(rowHeight, cells[i]->h);
+        atlasWidth = std::max(atlasWidth, penX);
+    }
+    atlasHeight = penY + rowHeight;
+
+    bool ok = atlasWidth > 0 && atlasHeight > 0;
+    SDL_Surface* atlas = ok ? SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32) : nullptr;
+    if (!atlas) {
+        if (ok) std::cerr << "GlyphAtlas: Failed to create atlas surface: " << SDL_GetError() << std::endl;
+        ok = false;
+    }
+    for (int i = 0; i < glyphCount; ++i) {
+        if (!cells[i]) continue;
+        if (atlas) {
+            SDL_SetSurfaceBlendMode(cells[i], SDL_BLENDMODE_NONE);
+            SDL_Rect dst = glyphs[i].src;
+            SDL_BlitSurface(cells[i], NULL, atlas, &dst);
+        }
+        SDL_FreeSurface(cells[i]);
+    }
+    if (!ok) return false;
+
+    texture = SDL_CreateTextureFromSurface(renderer, atlas);
+    SDL_FreeSurface(atlas);
+    if (!texture) {
+        std::cerr << "GlyphAtlas: Failed to create atlas texture: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    kerning.assign(glyphCount * glyphCount, 0);
+    for (int a = 0; a < glyphCount; ++a) {
+        for (int b = 0; b < glyphCount; ++b) {
+            int k = TTF_GetFontKerningSizeGlyphs(font, static_cast<Uint16>(firstChar + a), static_cast<Uint16>(firstChar + b));
+            kerning[a * glyphCount + b] = static_cast<signed char>(std::max(-128, std::min(127, k)));
+        }
+    }
+    return true;
+}
+
+bool GlyphAtlas::canDraw(const std::string& text) const {
+    if (!texture) return false;
+    for (char c : text) {
+        if (c < firstChar || c > lastChar) return false;
+    }
+    return true;
+}
+
+void GlyphAtlas::appendText(const std::string& text, int x, int y, SDL_Color color) {
+    if (!texture) return;
+    const float invW = 1.0f / atlasWidth;
+    const float invH = 1.0f / atlasHeight;
+
+    int penX = x;
+    int previous = -1;
+    for (char c : text) {
+        if (c < firstChar || c > lastChar) continue;
+        int index = c - firstChar;
+        if (previous >= 0) penX += kerning[previous * glyphCount + index];
+        previous = index;
+
+        const Glyph& glyph = glyphs[index];
+        if (glyph.src.w > 0) {
+            float x0 = static_cast<float>(penX + glyph.offsetX), y0 = static_cast<float>(y);
+            float x1 = x0 + glyph.src.w, y1 = y0 + glyph.src.h;
+            float u0 = glyph.src.x * invW, v0 = glyph.src.y * invH;
+            float u1 = (glyph.src.x + glyph.src.w) * invW, v1 = (glyph.src.y + glyph.src.h) * invH;
+
+            int base = static_cast<int>(vertices.size());
+            vertices.push_back(SDL_Vertex{SDL_FPoint{x0, y0}, color, SDL_FPoint{u0, v0}});
+            vertices.push_back(SDL_Vertex{SDL_FPoint{x1, y0}, color, SDL_FPoint{u1, v0}});
+            vertices.push_back(SDL_Vertex{SDL_FPoint{x1, y1}, color, SDL_FPoint{u1, v1}});
+            vertices.push_back(SDL_Vertex{SDL_FPoint{x0, y1}, color, SDL_FPoint{u0, v1}});
+            indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+        }
+        penX += glyph.advance;
+    }
+}
+
+void GlyphAtlas::flush(SDL_Renderer* renderer) {
+    if (!vertices.empty() && renderer && texture) {
+        TextureManager::RenderGeometry(renderer, texture, vertices.data(), static_cast<int>(vertices.size()), indices.data(), static_cast<int>(indices.size()));
+    }
+    vertices.clear();
+    indices.clear();
+}
+
+void GlyphAtlas::drawText(SDL_Renderer* renderer, const std::string& text, int x, int y, SDL_Color color) {
+    appendText(text, x, y, color);
+    flush(renderer);
+}
+
+void GlyphAtlas::drawTextWithOutline(SDL_Renderer* renderer, const std::string& text, int x, int y, SDL_Color textColor, SDL_Color outlineColor, int outlineWidth) {
+    for (int dy = -outlineWidth; dy <= outlineWidth; ++dy) {
+        for (int dx = -outlineWidth; dx <= outlineWidth; ++dx) {
+            if (dx == 0 && dy == 0) continue;
+            appendText(text, x + dx, y + dy, outlineColor);
+        }
+    }
+    appendText(text, x, y, textColor);
+    flush(renderer);
+}
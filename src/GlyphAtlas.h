@@ -0,0 +1,55 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+#include <vector>
+
+// Printable ASCII from one TTF_Font, rasterized once into a single white
+// texture. Strings are drawn as textured quads in one SDL_RenderGeometry
+// call, with the color carried in the vertices.
+class GlyphAtlas {
+public:
+    GlyphAtlas() = default;
+    ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    bool build(SDL_Renderer* renderer, TTF_Font* font);
+    void destroy();
+
+    bool isReady() const { return texture != nullptr; }
+    // False if the string has characters outside the baked range.
+    bool canDraw(const std::string& text) const;
+
+    // Appends the quads for text at (x, y) to the pending batch.
+    void appendText(const std::string& text, int x, int y, SDL_Color color);
+    void flush(SDL_Renderer* renderer);
+
+    void drawText(SDL_Renderer* renderer, const std::string& text, int x, int y, SDL_Color color);
+    void drawTextWithOutline(SDL_Renderer* renderer, const std::string& text, int x, int y, SDL_Color textColor, SDL_Color outlineColor, int outlineWidth);
+
+    int getLineHeight() const { return lineHeight; }
+
+private:
+    static const char firstChar = 32;
+    static const char lastChar = 126;
+    static const int glyphCount = lastChar - firstChar + 1;
+
+    struct Glyph {
+        SDL_Rect src = {0, 0, 0, 0};
+        int offsetX = 0;
+        int advance = 0;
+    };
+
+    SDL_Texture* texture = nullptr;
+    int atlasWidth = 0;
+    int atlasHeight = 0;
+    int lineHeight = 0;
+    Glyph glyphs[glyphCount];
+    std::vector<signed char> kerning;
+
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
@@ -0,0 +1,220 @@
+#include "JobSystem.h"
+#include <SDL.h>
+#include "constants.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+thread_local int tlsSlot = 0;
+
+std::uint64_t elapsedMicroseconds(std::chrono::steady_clock::time_point since) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - since).count());
+}
+}
+
+JobSystem& JobSystem::shared() {
+    static JobSystem jobs;
+    return jobs;
+}
+
+JobSystem::JobSystem(int workerCount) {
+    if (workerCount < 0) {
+        int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = std::min(std::max(hardware - 1, 0), JOB_SYSTEM_MAX_WORKERS);
+    }
+
+    queues.reserve(workerCount + 1);
+    for (int i = 0; i <= workerCount; ++i) queues.emplace_back(new TaskQueue());
+    threads.reserve(workerCount);
+    for (int i = 1; i <= workerCount; ++i) threads.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& thread : threads) thread.join();
+}
+
+int JobSystem::currentSlot() {
+    return tlsSlot;
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t grain, const RangeFunction& fn) {
+    if (count == 0) return;
+    grain = std::max<std::size_t>(grain, 1);
+    std::size_t chunks = (count + grain - 1) / grain;
+    if (threads.empty() || chunks == 1) {
+        for (std::size_t begin = 0; begin < count; begin += grain) fn(begin, std::min(begin + grain, count));
+        return;
+    }
+
+    std::atomic<std::size_t> remaining(chunks);
+    int slot = currentSlot();
+    {
+        // Pushed last-chunk-first so the owner, popping from the back, works front to back.
+        std::lock_guard<std::mutex> lock(queues[slot]->mutex);
+        for (std::size_t i = chunks; i-- > 0;) {
+            std::size_t begin = i * grain;
+            queues[slot]->tasks.push_back({&fn, begin, std::min(begin + grain, count), &remaining});
+        }
+    }
+    queuedTasks.fetch_add(static_cast<int>(chunks));
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wake.notify_all();
+
+    helpUntilDone(remaining);
+}
+
+void JobSystem::submit(const Task& task) {
+    {
+        TaskQueue& own = *queues[currentSlot()];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.tasks.push_back(task);
+    }
+    queuedTasks.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wake.notify_one();
+}
+
+void JobSystem::helpUntilDone(const std::atomic<std::size_t>& remaining) {
+    int slot = currentSlot();
+    Task task;
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (popOrSteal(slot, task)) {
+            runTask(task);
+            continue;
+        }
+        auto idleStart = std::chrono::steady_clock::now();
+        std::this_thread::yield();
+        queues[slot]->idleMicroseconds.fetch_add(elapsedMicroseconds(idleStart), std::memory_order_relaxed);
+    }
+}
+
+JobSystem::Stats JobSystem::getStats() const {
+    Stats stats;
+    for (const auto& queue : queues) {
+        stats.tasksRun += queue->tasksRun.load(std::memory_order_relaxed);
+        stats.tasksStolen += queue->tasksStolen.load(std::memory_order_relaxed);
+        stats.idleMicroseconds += queue->idleMicroseconds.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void JobSystem::resetStats() {
+    for (auto& queue : queues) {
+        queue->tasksRun.store(0, std::memory_order_relaxed);
+        queue->tasksStolen.store(0, std::memory_order_relaxed);
+        queue->idleMicroseconds.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool JobSystem::popOrSteal(int slot, Task& outTask) {
+    {
+        TaskQueue& own = *queues[slot];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            outTask = own.tasks.back();
+            own.tasks.pop_back();
+            queuedTasks.fetch_sub(1);
+            own.tasksRun.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    int slots = getSlotCount();
+    for (int i = 1; i < slots; ++i) {
+        TaskQueue& victim = *queues[(slot + i) % slots];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            outTask = victim.tasks.front();
+            victim.tasks.pop_front();
+            queuedTasks.fetch_sub(1);
+            queues[slot]->tasksRun.fetch_add(1, std::memory_order_relaxed);
+            queues[slot]->tasksStolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::runTask(const Task& task) {
+    (*task.fn)(task.begin, task.end);
+    task.remaining->fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::workerLoop(int slot) {
+    tlsSlot = slot;
+    Task task;
+    for (;;) {
+        if (popOrSteal(slot, task)) {
+            runTask(task);
+            continue;
+        }
+        auto idleStart = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait(lock, [this] { return stopping || queuedTasks.load() > 0; });
+        queues[slot]->idleMicroseconds.fetch_add(elapsedMicroseconds(idleStart), std::memory_order_relaxed);
+        if (stopping && queuedTasks.load() == 0) return;
+    }
+}
+
+int TaskGraph::add(TaskFunction fn) {
+    std::unique_ptr<Node> node(new Node());
+    node->fn = std::move(fn);
+    nodes.push_back(std::move(node));
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+void TaskGraph::precede(int before, int after) {
+    nodes[before]->successors.push_back(after);
+    ++nodes[after]->dependencyCount;
+}
+
+void TaskGraph::run(JobSystem& jobs) {
+    if (nodes.empty()) return;
+
+    std::atomic<std::size_t> remaining(nodes.size());
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        Node& node = *nodes[i];
+        node.pending.store(node.dependencyCount, std::memory_order_relaxed);
+        // A finished task releases its successors before it counts itself
+        // done, so remaining can't reach zero while any are still unqueued.
+        node.launch = [this, &jobs, &remaining, &node](std::size_t, std::size_t) {
+            node.fn();
+            for (int successor : node.successors) {
+                Node& next = *nodes[successor];
+                if (next.pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    jobs.submit({&next.launch, 0, 0, &remaining});
+                }
+            }
+        };
+    }
+
+    if (jobs.threads.empty()) {
+        // No workers: run in dependency order on this thread.
+        std::vector<int> ready;
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            if (nodes[i]->dependencyCount == 0) ready.push_back(static_cast<int>(i));
+        }
+        for (std::size_t i = 0; i < ready.size(); ++i) {
+            Node& node = *nodes[ready[i]];
+            node.fn();
+            for (int successor : node.successors) {
+                if (--nodes[successor]->pending == 0) ready.push_back(successor);
+            }
+        }
+        return;
+    }
+
+    for (auto& node : nodes) {
+        if (node->dependencyCount == 0) jobs.submit({&node->launch, 0, 0, &remaining});
+    }
+    jobs.helpUntilDone(remaining);
+}
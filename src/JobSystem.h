@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small work-stealing pool. Each thread owns a task deque: it pops its own
+// newest work from the back while idle threads steal the oldest from the
+// front. A thread waiting on a parallelFor keeps running tasks instead of
+// blocking, so nested calls from inside a task are fine.
+//
+// Chunks may run on any thread in any order; callers that need a
+// deterministic result write per-index outputs and merge them afterwards.
+class JobSystem {
+public:
+    using RangeFunction = std::function<void(std::size_t begin, std::size_t end)>;
+
+    // Totals since the last resetStats(), summed over every slot.
+    struct Stats {
+        std::uint64_t tasksRun = 0;
+        std::uint64_t tasksStolen = 0;
+        // Time workers spent asleep plus time waiting callers found nothing to run.
+        std::uint64_t idleMicroseconds = 0;
+    };
+
+    static JobSystem& shared();
+
+    // workerCount < 0 picks one worker per spare hardware thread.
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Calls fn over [0, count) in chunks of at most grain and returns once all
+    // chunks are done. Runs inline when there are no workers.
+    void parallelFor(std::size_t count, std::size_t grain, const RangeFunction& fn);
+
+    // Worker threads plus the slot shared by every thread outside the pool.
+    int getSlotCount() const { return static_cast<int>(queues.size()); }
+    // 0 outside the pool, 1..workers on pool threads; for per-thread scratch.
+    static int currentSlot();
+
+    Stats getStats() const;
+    void resetStats();
+
+private:
+    friend class TaskGraph;
+
+    struct Task {
+        const RangeFunction* fn = nullptr;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        std::atomic<std::size_t>* remaining = nullptr;
+    };
+
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::atomic<std::uint64_t> tasksRun{0};
+        std::atomic<std::uint64_t> tasksStolen{0};
+        std::atomic<std::uint64_t> idleMicroseconds{0};
+    };
+
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<int> queuedTasks{0};
+    bool stopping = false;
+
+    void submit(const Task& task);
+    // Runs queued tasks on the calling thread until remaining reaches zero.
+    void helpUntilDone(const std::atomic<std::size_t>& remaining);
+    bool popOrSteal(int slot, Task& outTask);
+    void runTask(const Task& task);
+    void workerLoop(int slot);
+};
+
+// Tasks with ordering constraints, built once and run as often as needed.
+// A task starts once every task it depends on has finished; tasks without a
+// path between them may run at the same time. Tasks can call parallelFor.
+class TaskGraph {
+public:
+    using TaskFunction = std::function<void()>;
+
+    int add(TaskFunction fn);
+    // after will not start until before has finished.
+    void precede(int before, int after);
+    // Blocks until every task has run; the caller works on them meanwhile.
+    void run(JobSystem& jobs);
+
+    void clear() { nodes.clear(); }
+    bool empty() const { return nodes.empty(); }
+
+private:
+    struct Node {
+        TaskFunction fn;
+        std::vector<int> successors;
+        int dependencyCount = 0;
+        std::atomic<int> pending{0};
+        JobSystem::RangeFunction launch;
+    };
+
+    std::vector<std::unique_ptr<Node>> nodes;
+};
@@ -0,0 +1,321 @@
+#include "MapFile.h"
+#include "map.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char mapMagic[4] = {'M', 'S', 'M', 'P'};
+    const std::uint16_t mapVersion = 3;
+    const std::size_t headerSize = 24;
+
+    std::size_t solidWordCount(std::size_t cells) { return (cells + 63) / 64; }
+    std::size_t tilesEnd(std::size_t cells) { return headerSize + cells * 2; }
+    std::size_t solidOffset(std::size_t cells) { return (tilesEnd(cells) + 7) & ~std::size_t{7}; }
+    std::size_t spawnOffset(std::size_t cells) { return solidOffset(cells) + solidWordCount(cells) * 8; }
+    int chunkCount(std::uint32_t tiles, int chunkTiles) { return static_cast<int>((tiles + chunkTiles - 1) / chunkTiles); }
+
+    void putU16(std::uint8_t* at, std::uint16_t value) {
+        at[0] = static_cast<std::uint8_t>(value & 0xFF);
+        at[1] = static_cast<std::uint8_t>(value >> 8);
+    }
+    void putU32(std::uint8_t* at, std::uint32_t value) {
+        putU16(at, static_cast<std::uint16_t>(value & 0xFFFF));
+        putU16(at + 2, static_cast<std::uint16_t>(value >> 16));
+    }
+    std::uint16_t getU16(const std::uint8_t* at) {
+        return static_cast<std::uint16_t>(at[0] | (at[1] << 8));
+    }
+    std::uint32_t getU32(const std::uint8_t* at) {
+        return getU16(at) | (static_cast<std::uint32_t>(getU16(at + 2)) << 16);
+    }
+}
+
+std::uint64_t MapFile::View::solidWord(std::size_t index) const {
+    const std::uint8_t* at = solidWords + index * 8;
+    return getU32(at) | (static_cast<std::uint64_t>(getU32(at + 4)) << 32);
+}
+
+void MapFile::View::chunkSpawns(int chunkIndex, std::size_t& first, std::size_t& count) const {
+    first = getU32(spawnIndex + static_cast<std::size_t>(chunkIndex) * 4);
+    count = getU32(spawnIndex + static_cast<std::size_t>(chunkIndex + 1) * 4) - first;
+}
+
+void MapFile::View::spawnAt(std::size_t index, int& tileX, int& tileY) const {
+    tileX = getU16(spawns + index * 4);
+    tileY = getU16(spawns + index * 4 + 2);
+}
+
+bool MapFile::compileCsv(const std::string& csvPath, int chunkTiles, std::vector<std::uint8_t>& out) {
+    if (chunkTiles <= 0 || chunkTiles > 0xFFFF) {
+        std::cerr << "MapFile: Invalid chunk size " << chunkTiles << "." << std::endl;
+        return false;
+    }
+    std::ifstream in(csvPath, std::ios::binary);
+    if (!in) {
+        std::cerr << "MapFile: Could not open map file: " << csvPath << std::endl;
+        return false;
+    }
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    // First pass: fields are split on ',' and checked like the old std::stoi
+    // loader. A row with a field that doesn't start with a number (including a
+    // lone '\r' after a trailing comma) is dropped whole, and the rows after it
+    // move up. The map is as tall as the rows kept and as wide as the longest.
+    std::vector<int> values;
+    std::vector<std::size_t> rowStarts;
+    std::size_t width = 0;
+    const char* cursor = text.c_str();
+    const char* end = cursor + text.size();
+    while (cursor < end) {
+        const char* lineEnd = cursor;
+        while (lineEnd < end && *lineEnd != '\n') ++lineEnd;
+
+        std::size_t rowStart = values.size();
+        bool valid = true;
+        if (*cursor != '#') {
+            const char* p = cursor;
+            while (p < lineEnd) {
+                const char* tokenEnd = p;
+                while (tokenEnd < lineEnd && *tokenEnd != ',') ++tokenEnd;
+                char* parsedEnd = nullptr;
+                errno = 0;
+                long value = std::strtol(p, &parsedEnd, 10);
+                // strtol skips whitespace, newlines included, so it can run past the token.
+                if (parsedEnd == p || parsedEnd > tokenEnd || errno == ERANGE) {
+                    std::cerr << "MapFile: Invalid value on row " << rowStarts.size() << " of " << csvPath << ". Skipping row." << std::endl;
+                    valid = false;
+                    break;
+                }
+                values.push_back(static_cast<int>(value));
+                p = tokenEnd < lineEnd ? tokenEnd + 1 : lineEnd;
+            }
+        }
+
+        if (valid && values.size() > rowStart) {
+            rowStarts.push_back(rowStart);
+            width = std::max(width, values.size() - rowStart);
+        } else {
+            values.resize(rowStart);
+        }
+        cursor = lineEnd + 1;
+    }
+    rowStarts.push_back(values.size());
+
+    const std::size_t height = rowStarts.size() - 1;
+    if (width == 0 || height == 0 || width > 0xFFFF || height > 0xFFFF) {
+        std::cerr << "MapFile: " << csvPath << " has an unusable size of " << width << "x" << height << " tiles." << std::endl;
+        return false;
+    }
+
+    const std::size_t cells = width * height;
+    out.assign(spawnOffset(cells), 0);
+    std::copy(mapMagic, mapMagic + 4, out.begin());
+    putU16(&out[4], mapVersion);
+    putU16(&out[6], static_cast<std::uint16_t>(chunkTiles));
+    putU32(&out[8], static_cast<std::uint32_t>(width));
+    putU32(&out[12], static_cast<std::uint32_t>(height));
+    for (std::size_t cell = 0; cell < cells; ++cell) putU16(&out[headerSize + cell * 2], emptyTile);
+
+    std::vector<std::uint64_t> solid(solidWordCount(cells), 0);
+    // Spawns per chunk, each list in row-major order. Short rows are padded with empty tiles.
+    const int chunksX = chunkCount(static_cast<int>(width), chunkTiles);
+    const int chunksY = chunkCount(static_cast<int>(height), chunkTiles);
+    std::vector<std::vector<std::uint16_t>> chunkSpawnCoords(static_cast<std::size_t>(chunksX) * chunksY);
+    for (std::size_t y = 0; y < height; ++y) {
+        for (std::size_t i = rowStarts[y]; i < rowStarts[y + 1]; ++i) {
+            std::size_t x = i - rowStarts[y];
+            int tileCode = values[i];
+            if (tileCode < 0 || tileCode >= emptyTile) continue;
+            std::size_t cell = y * width + x;
+            putU16(&out[headerSize + cell * 2], static_cast<std::uint16_t>(tileCode));
+            if (Map::isSolidTileCode(tileCode)) solid[cell >> 6] |= std::uint64_t{1} << (cell & 63);
+            if (Map::isSpawnTileCode(tileCode)) {
+                auto& coords = chunkSpawnCoords[(y / chunkTiles) * chunksX + x / chunkTiles];
+                coords.push_back(static_cast<std::uint16_t>(x));
+                coords.push_back(static_cast<std::uint16_t>(y));
+            }
+        }
+    }
+
+    std::size_t solidAt = solidOffset(cells);
+    for (std::size_t i = 0; i < solid.size(); ++i) {
+        putU32(&out[solidAt + i * 8], static_cast<std::uint32_t>(solid[i] & 0xFFFFFFFFu));
+        putU32(&out[solidAt + i * 8 + 4], static_cast<std::uint32_t>(solid[i] >> 32));
+    }
+    std::vector<std::uint32_t> firstSpawn;
+    firstSpawn.reserve(chunkSpawnCoords.size() + 1);
+    std::uint32_t spawnCount = 0;
+    for (const auto& coords : chunkSpawnCoords) {
+        firstSpawn.push_back(spawnCount);
+        for (std::uint16_t coord : coords) {
+            std::size_t at = out.size();
+            out.resize(at + 2);
+            putU16(&out[at], coord);
+        }
+        spawnCount += static_cast<std::uint32_t>(coords.size() / 2);
+    }
+    firstSpawn.push_back(spawnCount);
+    putU32(&out[16], spawnCount);
+
+    std::size_t indexAt = out.size();
+    out.resize(indexAt + firstSpawn.size() * 4);
+    for (std::size_t i = 0; i < firstSpawn.size(); ++i) putU32(&out[indexAt + i * 4], firstSpawn[i]);
+    return true;
+}
+
+bool MapFile::writeFile(const std::string& path, const std::vector<std::uint8_t>& image) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "MapFile: Failed to open '" << path << "' for writing." << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    if (!out) {
+        std::cerr << "MapFile: Failed to write '" << path << "'." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool MapFile::parse(const std::uint8_t* data, std::size_t size, View& view) {
+    if (!data || size < headerSize || !std::equal(mapMagic, mapMagic + 4, data)) {
+        std::cerr << "MapFile: Not a compiled map." << std::endl;
+        return false;
+    }
+    std::uint16_t version = getU16(data + 4);
+    if (version != mapVersion) {
+        std::cerr << "MapFile: Compiled map has version " << version << "; expected " << mapVersion << "." << std::endl;
+        return false;
+    }
+
+    view.width = getU32(data + 8);
+    view.height = getU32(data + 12);
+    view.spawnCount = getU32(data + 16);
+    view.chunkTiles = getU16(data + 6);
+    const std::size_t cells = static_cast<std::size_t>(view.width) * view.height;
+    if (view.width == 0 || view.height == 0 || view.width > 0xFFFF || view.height > 0xFFFF || view.chunkTiles == 0) {
+        std::cerr << "MapFile: Compiled map has a bad header." << std::endl;
+        return false;
+    }
+    view.chunksX = chunkCount(view.width, view.chunkTiles);
+    view.chunksY = chunkCount(view.height, view.chunkTiles);
+    const std::size_t indexOffset = spawnOffset(cells) + static_cast<std::size_t>(view.spawnCount) * 4;
+    const std::size_t chunks = static_cast<std::size_t>(view.chunksX) * view.chunksY;
+    if (indexOffset + (chunks + 1) * 4 > size) {
+        std::cerr << "MapFile: Compiled map is truncated." << std::endl;
+        return false;
+    }
+    view.tiles = data + headerSize;
+    view.solidWords = data + solidOffset(cells);
+    view.spawns = data + spawnOffset(cells);
+    view.spawnIndex = data + indexOffset;
+    std::uint32_t previous = 0;
+    for (std::size_t i = 0; i <= chunks; ++i) {
+        std::uint32_t first = getU32(view.spawnIndex + i * 4);
+        if (first < previous || first > view.spawnCount || (i == chunks && first != view.spawnCount)) {
+            std::cerr << "MapFile: Compiled map has a bad spawn index." << std::endl;
+            return false;
+        }
+        previous = first;
+    }
+    return true;
+}
+
+std::string MapFile::compiledPathFor(const std::string& path) {
+    std::filesystem::path compiled(path);
+    if (compiled.extension() == ".mapb") return path;
+    compiled.replace_extension(".mapb");
+    return compiled.string();
+}
+
+bool MapFile::isStale(const std::string& compiledPath, const std::string& sourcePath) {
+    std::error_code ec;
+    if (!std::filesystem::exists(compiledPath, ec)) return true;
+    if (!std::filesystem::exists(sourcePath, ec)) return false;
+    auto compiledTime = std::filesystem::last_write_time(compiledPath, ec);
+    if (ec) return true;
+    auto sourceTime = std::filesystem::last_write_time(sourcePath, ec);
+    if (ec) return false;
+    return sourceTime > compiledTime;
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+bool MappedFile::open(const std::string& path) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    bytes = static_cast<const std::uint8_t*>(view);
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    bytes = nullptr;
+    length = 0;
+    mappingHandle = fileHandle = nullptr;
+}
+#else
+bool MappedFile::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed.
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+    bytes = static_cast<const std::uint8_t*>(view);
+    length = static_cast<std::size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes) munmap(const_cast<std::uint8_t*>(bytes), length);
+    bytes = nullptr;
+    length = 0;
+}
+#endif
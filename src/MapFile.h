@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Compiled map layout, all little-endian:
+//   header      "MSMP", u16 version, u16 chunk size in tiles, u32 width,
+//               u32 height, u32 spawn count, u32 reserved        (24 bytes)
+//   tiles       u16 per cell, row-major, 0xFFFF for an empty cell
+//   solid bits  u64 words, bit (y * width + x), starting on an 8-byte boundary
+//   spawns      u16 tile x, u16 tile y per spawn point, grouped by chunk
+//   spawn index u32 per chunk (row-major) plus one: first spawn of each chunk
+class MapFile {
+public:
+    static const std::uint16_t emptyTile = 0xFFFF;
+
+    // Points into a compiled image; only valid while that memory is.
+    struct View {
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        std::uint32_t spawnCount = 0;
+        int chunkTiles = 0;
+        int chunksX = 0;
+        int chunksY = 0;
+        const std::uint8_t* tiles = nullptr;
+        const std::uint8_t* solidWords = nullptr;
+        const std::uint8_t* spawns = nullptr;
+        const std::uint8_t* spawnIndex = nullptr;
+
+        std::uint16_t tileAt(std::size_t cell) const { return static_cast<std::uint16_t>(tiles[cell * 2] | (tiles[cell * 2 + 1] << 8)); }
+        std::uint64_t solidWord(std::size_t index) const;
+        void spawnAt(std::size_t index, int& tileX, int& tileY) const;
+        // Spawns [first, first + count) lie in the given chunk.
+        void chunkSpawns(int chunkIndex, std::size_t& first, std::size_t& count) const;
+    };
+
+    // Reads the CSV .map format (one row per line, '#' comments) into a compiled
+    // image sized by the file: one row per valid line, as wide as the longest row.
+    static bool compileCsv(const std::string& csvPath, int chunkTiles, std::vector<std::uint8_t>& out);
+    static bool writeFile(const std::string& path, const std::vector<std::uint8_t>& image);
+    // Checks the header and that every section fits in size.
+    static bool parse(const std::uint8_t* data, std::size_t size, View& view);
+
+    // "assets/map.map" -> "assets/map.mapb"; compiled paths are returned unchanged.
+    static std::string compiledPathFor(const std::string& path);
+    // True if compiledPath is missing or older than sourcePath.
+    static bool isStale(const std::string& compiledPath, const std::string& sourcePath);
+};
+
+// Read-only memory mapping of a whole file.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    const std::uint8_t* data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+private:
+    const std::uint8_t* bytes = nullptr;
+    std::size_t length = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
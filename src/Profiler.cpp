@@ -0,0 +1,147 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    const std::size_t ringCapacity = 1 << 16;
+
+    // Fields are atomics because a dump reads other threads' rings while they
+    // are still recording; relaxed accesses cost nothing extra on the write side.
+    struct Slot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<Uint64> start{0};
+        std::atomic<Uint64> end{0};
+    };
+
+    struct ThreadBuffer {
+        std::unique_ptr<Slot[]> events;
+        // Total events ever written; the slot is head % ringCapacity.
+        std::atomic<std::uint64_t> head{0};
+        std::uint32_t threadId = 0;
+        std::string name;
+    };
+
+    std::atomic<bool> profilerEnabled{true};
+    std::mutex registryMutex;
+    // Buffers are never freed so a dump can still read threads that have exited.
+    std::vector<std::unique_ptr<ThreadBuffer>> registry;
+
+    ThreadBuffer& localBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer) {
+            std::unique_ptr<ThreadBuffer> created(new ThreadBuffer());
+            created->events.reset(new Slot[ringCapacity]);
+            std::lock_guard<std::mutex> lock(registryMutex);
+            created->threadId = static_cast<std::uint32_t>(registry.size() + 1);
+            created->name = created->threadId == 1 ? "Main" : "Worker " + std::to_string(created->threadId - 1);
+            buffer = created.get();
+            registry.push_back(std::move(created));
+        }
+        return *buffer;
+    }
+
+    void writeEscaped(std::ofstream& out, const std::string& text) {
+        for (char c : text) {
+            if (c == '"' || c == '\\') out << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20) out << ' ';
+            else out << c;
+        }
+    }
+}
+
+void Profiler::setEnabled(bool enabled) {
+    profilerEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::isEnabled() {
+    return profilerEnabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::setThreadName(const char* name) {
+    ThreadBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer.name = name ? name : "";
+}
+
+void Profiler::record(const char* name, Uint64 start, Uint64 end) {
+    ThreadBuffer& buffer = localBuffer();
+    std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    // Orders the previous head store before this slot is overwritten, so a
+    // reader that sees any of the new fields also sees that head moved on.
+    std::atomic_thread_fence(std::memory_order_release);
+    Slot& slot = buffer.events[head % ringCapacity];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Profiler: Failed to open '" << path << "' for writing." << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    // Copy every ring once, then re-read head: anything the writer may have
+    // started overwriting meanwhile is dropped, so the copy is consistent and
+    // both origin and the output below come from it.
+    struct Snapshot { const ThreadBuffer* buffer; std::vector<Event> events; };
+    std::vector<Snapshot> snapshots;
+    Uint64 origin = std::numeric_limits<Uint64>::max();
+    for (const auto& buffer : registry) {
+        std::uint64_t last = buffer->head.load(std::memory_order_acquire);
+        std::uint64_t first = last > ringCapacity ? last - ringCapacity : 0;
+        std::vector<Event> copied;
+        copied.reserve(static_cast<std::size_t>(last - first));
+        for (std::uint64_t i = first; i < last; ++i) {
+            const Slot& slot = buffer->events[i % ringCapacity];
+            copied.push_back(Event{slot.name.load(std::memory_order_relaxed), slot.start.load(std::memory_order_relaxed), slot.end.load(std::memory_order_relaxed)});
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // The write at index `after` may be in progress, so its slot is suspect too.
+        std::uint64_t after = buffer->head.load(std::memory_order_relaxed);
+        std::uint64_t intact = after + 1 > ringCapacity ? after + 1 - ringCapacity : 0;
+        if (intact > first) copied.erase(copied.begin(), copied.begin() + static_cast<std::ptrdiff_t>(std::min(intact, last) - first));
+
+        for (const Event& e : copied) origin = std::min(origin, e.start);
+        snapshots.push_back(Snapshot{buffer.get(), std::move(copied)});
+    }
+
+    const double toMicroseconds = 1000000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    std::size_t written = 0;
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool firstEntry = true;
+    for (const Snapshot& snapshot : snapshots) {
+        out << (firstEntry ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << snapshot.buffer->threadId << ",\"args\":{\"name\":\"";
+        writeEscaped(out, snapshot.buffer->name);
+        out << "\"}}";
+        firstEntry = false;
+
+        for (const Event& e : snapshot.events) {
+            if (!e.name || e.end < e.start) continue;
+            out << ",\n{\"name\":\"";
+            writeEscaped(out, e.name);
+            out << "\",\"cat\":\"game\",\"ph\":\"X\",\"pid\":1,\"tid\":" << snapshot.buffer->threadId
+                << ",\"ts\":" << (e.start - origin) * toMicroseconds
+                << ",\"dur\":" << (e.end - e.start) * toMicroseconds << "}";
+            ++written;
+        }
+    }
+    out << "\n]}\n";
+
+    std::cout << "Profiler: Wrote " << written << " events to '" << path << "'." << std::endl;
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SDL.h>
+#include <string>
+
+// Scoped CPU timer. Each thread records into its own fixed-size ring buffer,
+// so only the most recent events are kept. writeChromeTrace dumps them in the
+// JSON format read by chrome://tracing and Perfetto.
+class Profiler {
+public:
+    struct Event {
+        const char* name;
+        Uint64 start;
+        Uint64 end;
+    };
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+    static void setThreadName(const char* name);
+
+    static Uint64 now() { return SDL_GetPerformanceCounter(); }
+    static void record(const char* name, Uint64 start, Uint64 end);
+
+    static bool writeChromeTrace(const std::string& path);
+};
+
+class ProfileScope {
+public:
+    // name must outlive the profiler (use string literals).
+    explicit ProfileScope(const char* scopeName)
+        : name(scopeName), start(Profiler::isEnabled() ? Profiler::now() : 0) {}
+    ~ProfileScope() {
+        if (start) Profiler::record(name, start, Profiler::now());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    Uint64 start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
@@ -0,0 +1,67 @@
+#include "ProjectilePool.h"
+#include "game.h"
+#include "ECS/Components.h"
+
+ProjectilePool::ProjectilePool(Manager* man, std::size_t highWater) : manager(man), highWaterMark(highWater) {
+    parked.reserve(highWaterMark);
+}
+
+ProjectilePool::~ProjectilePool() {
+    if (manager) manager->detachRecycler(this);
+}
+
+Entity& ProjectilePool::acquire(Vector2D pos, Vector2D vel, int damage, int size, const std::string& id, int pierce) {
+    if (parked.empty()) {
+        auto& projectile(manager->addEntity());
+        projectile.addComponent<TransformComponent>(pos.x, pos.y, size, size, 1);
+        projectile.addComponent<SpriteComponent>(id);
+        projectile.addComponent<ProjectileComponent>(damage, vel, pierce);
+        projectile.addComponent<ColliderComponent>("projectile");
+        projectile.setRecycler(this);
+        projectile.addGroup(Game::groupProjectiles);
+        return projectile;
+    }
+
+    Entity& projectile = *parked.back();
+    parked.pop_back();
+    manager->reviveEntity(projectile);
+    ++reuseCount;
+
+    // Same order as a fresh projectile: later components read the transform in init().
+    TransformComponent& transform = projectile.getComponent<TransformComponent>();
+    transform.position = pos;
+    transform.resetInterpolation();
+    transform.velocity.Zero();
+    transform.width = size;
+    transform.height = size;
+    transform.scale = 1;
+    projectile.getComponent<SpriteComponent>().reset(id);
+    projectile.getComponent<ProjectileComponent>().reset(damage, vel, pierce);
+    projectile.getComponent<ColliderComponent>().resetSize();
+    // The resets only size the collider and sprite; they still sit where the
+    // entity died. Place them now, since a projectile fired by an entity that
+    // updates later in the tick is collision-tested before its own update runs.
+    projectile.getComponent<ColliderComponent>().update();
+    projectile.getComponent<SpriteComponent>().update();
+    projectile.addGroup(Game::groupProjectiles);
+    return projectile;
+}
+
+bool ProjectilePool::recycle(Entity& entity) {
+    if (parked.size() >= highWaterMark) return false;
+    parked.push_back(&entity);
+    return true;
+}
+
+void ProjectilePool::setHighWaterMark(std::size_t highWater) {
+    highWaterMark = highWater;
+    if (parked.size() > highWaterMark) {
+        // Surplus entities are handed back to the Manager and freed on its next refresh.
+        for (std::size_t i = highWaterMark; i < parked.size(); ++i) {
+            manager->reviveEntity(*parked[i]);
+            parked[i]->setRecycler(nullptr);
+            parked[i]->destroy();
+        }
+        parked.resize(highWaterMark);
+    }
+}
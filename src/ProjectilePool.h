@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Vector2D.h"
+#include "ECS/ECS.h"
+
+class ProjectilePool : public EntityRecycler {
+public:
+    ProjectilePool(Manager* man, std::size_t highWater);
+    ~ProjectilePool();
+
+    Entity& acquire(Vector2D pos, Vector2D vel, int damage, int size, const std::string& id, int pierce);
+    bool recycle(Entity& entity) override;
+
+    void setHighWaterMark(std::size_t highWater);
+    std::size_t getHighWaterMark() const { return highWaterMark; }
+    std::size_t getParkedCount() const { return parked.size(); }
+    std::size_t getReuseCount() const { return reuseCount; }
+
+private:
+    Manager* manager;
+    std::size_t highWaterMark;
+    std::vector<Entity*> parked;
+    std::size_t reuseCount = 0;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+// Seedable generator for everything that affects the simulation. Range
+// reduction is done here rather than with <random> distributions so a seed
+// produces the same sequence on every standard library.
+class Random {
+public:
+    explicit Random(std::uint32_t seed = 5489u) : engine(seed), currentSeed(seed) {}
+
+    void seed(std::uint32_t newSeed) {
+        engine.seed(newSeed);
+        currentSeed = newSeed;
+    }
+    std::uint32_t getSeed() const { return currentSeed; }
+
+    // Uniform in [0, bound). Returns 0 when bound <= 0.
+    int nextInt(int bound) {
+        if (bound <= 0) return 0;
+        return static_cast<int>(engine() % static_cast<std::uint32_t>(bound));
+    }
+
+    // Uniform in [0, 1).
+    float nextFloat() {
+        return static_cast<float>(engine() >> 8) * (1.0f / 16777216.0f);
+    }
+
+private:
+    std::mt19937 engine;
+    std::uint32_t currentSeed;
+};
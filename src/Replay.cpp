@@ -0,0 +1,193 @@
+#include "Replay.h"
+#include "constants.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    const char replayMagic[4] = {'M', 'S', 'R', 'P'};
+    const std::uint16_t replayVersion = 1;
+
+    // Record tag layout: bit 7 set marks a buff pick (low bits = option index).
+    // Otherwise it is one tick: bits 0-3 are the movement keys, bit 4 means a
+    // new aim point follows, bit 5 means a new viewport size follows.
+    const std::uint8_t buffChoiceFlag = 0x80;
+    const std::uint8_t mouseChangedFlag = 0x10;
+    const std::uint8_t viewportChangedFlag = 0x20;
+    const SDL_Scancode recordedKeys[4] = {SDL_SCANCODE_W, SDL_SCANCODE_A, SDL_SCANCODE_S, SDL_SCANCODE_D};
+}
+
+Replay::~Replay() {
+    stop();
+}
+
+bool Replay::startRecording(const std::string& path, std::uint32_t recordSeed) {
+    stop();
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Replay: Failed to open '" << path << "' for recording." << std::endl;
+        return false;
+    }
+
+    outPath = path;
+    seed = recordSeed;
+    tickCount = 0;
+    lastMouseX = lastMouseY = 0;
+    viewWidth = viewHeight = 0;
+
+    out.write(replayMagic, sizeof(replayMagic));
+    writeU16(replayVersion);
+    writeU16(static_cast<std::uint16_t>(FPS));
+    writeU32(seed);
+    mode = Mode::Recording;
+    std::cout << "Replay: Recording to '" << path << "' (seed " << seed << ")." << std::endl;
+    return true;
+}
+
+bool Replay::startPlayback(const std::string& path) {
+    stop();
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Replay: Failed to open '" << path << "' for playback." << std::endl;
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    cursor = 0;
+
+    std::uint16_t version = 0, ticksPerSecond = 0;
+    if (data.size() < sizeof(replayMagic) || !std::equal(replayMagic, replayMagic + 4, data.begin())) {
+        std::cerr << "Replay: '" << path << "' is not a replay file." << std::endl;
+        data.clear();
+        return false;
+    }
+    cursor = sizeof(replayMagic);
+    if (!readU16(version) || !readU16(ticksPerSecond) || !readU32(seed)) {
+        std::cerr << "Replay: '" << path << "' has a truncated header." << std::endl;
+        data.clear();
+        return false;
+    }
+    if (version != replayVersion || ticksPerSecond != FPS) {
+        std::cerr << "Replay: '" << path << "' was recorded with version " << version << " at "
+                  << ticksPerSecond << " ticks/s; expected version " << replayVersion << " at " << FPS << "." << std::endl;
+        data.clear();
+        return false;
+    }
+
+    tickCount = 0;
+    keys.fill(0);
+    lastMouseX = lastMouseY = 0;
+    viewWidth = viewHeight = 0;
+    mode = Mode::Playing;
+    std::cout << "Replay: Playing '" << path << "' (seed " << seed << ")." << std::endl;
+    return true;
+}
+
+void Replay::stop() {
+    if (mode == Mode::Recording) {
+        out.close();
+        std::cout << "Replay: Wrote " << tickCount << " ticks to '" << outPath << "'." << std::endl;
+    } else if (mode == Mode::Playing) {
+        std::cout << "Replay: Played back " << tickCount << " ticks." << std::endl;
+    }
+    data.clear();
+    data.shrink_to_fit();
+    cursor = 0;
+    mode = Mode::Off;
+}
+
+void Replay::recordTick(const Uint8* keyboardState, int mouseX, int mouseY, int newViewWidth, int newViewHeight) {
+    if (mode != Mode::Recording) return;
+
+    std::uint8_t tag = 0;
+    for (int i = 0; i < 4; ++i) {
+        if (keyboardState && keyboardState[recordedKeys[i]]) tag |= static_cast<std::uint8_t>(1u << i);
+    }
+    bool mouseChanged = tickCount == 0 || mouseX != lastMouseX || mouseY != lastMouseY;
+    bool viewportChanged = newViewWidth != viewWidth || newViewHeight != viewHeight;
+    if (mouseChanged) tag |= mouseChangedFlag;
+    if (viewportChanged) tag |= viewportChangedFlag;
+
+    out.put(static_cast<char>(tag));
+    if (mouseChanged) {
+        writeU32(static_cast<std::uint32_t>(mouseX));
+        writeU32(static_cast<std::uint32_t>(mouseY));
+        lastMouseX = mouseX;
+        lastMouseY = mouseY;
+    }
+    if (viewportChanged) {
+        writeU16(static_cast<std::uint16_t>(newViewWidth));
+        writeU16(static_cast<std::uint16_t>(newViewHeight));
+        viewWidth = newViewWidth;
+        viewHeight = newViewHeight;
+    }
+    ++tickCount;
+}
+
+void Replay::recordBuffChoice(int index) {
+    if (mode != Mode::Recording) return;
+    // Out-of-range picks still close the selection, so they are kept as an invalid index.
+    if (index < 0 || index >= buffChoiceFlag) index = buffChoiceFlag - 1;
+    out.put(static_cast<char>(buffChoiceFlag | index));
+}
+
+bool Replay::nextBuffChoice(int& index) {
+    if (mode != Mode::Playing || cursor >= data.size() || !(data[cursor] & buffChoiceFlag)) return false;
+    index = data[cursor++] & ~buffChoiceFlag;
+    return true;
+}
+
+bool Replay::nextTick(int& mouseX, int& mouseY) {
+    if (mode != Mode::Playing || cursor >= data.size()) return false;
+
+    std::uint8_t tag = data[cursor];
+    if (tag & buffChoiceFlag) {
+        std::cerr << "Replay: Desync at tick " << tickCount << ", a buff pick is pending but none was offered." << std::endl;
+        return false;
+    }
+    ++cursor;
+
+    for (int i = 0; i < 4; ++i) {
+        keys[recordedKeys[i]] = (tag & (1u << i)) ? 1 : 0;
+    }
+    if (tag & mouseChangedFlag) {
+        std::uint32_t x = 0, y = 0;
+        if (!readU32(x) || !readU32(y)) return false;
+        lastMouseX = static_cast<int>(x);
+        lastMouseY = static_cast<int>(y);
+    }
+    if (tag & viewportChangedFlag) {
+        std::uint16_t w = 0, h = 0;
+        if (!readU16(w) || !readU16(h)) return false;
+        viewWidth = w;
+        viewHeight = h;
+    }
+
+    mouseX = lastMouseX;
+    mouseY = lastMouseY;
+    ++tickCount;
+    return true;
+}
+
+void Replay::writeU16(std::uint16_t value) {
+    out.put(static_cast<char>(value & 0xFF));
+    out.put(static_cast<char>((value >> 8) & 0xFF));
+}
+
+void Replay::writeU32(std::uint32_t value) {
+    writeU16(static_cast<std::uint16_t>(value & 0xFFFF));
+    writeU16(static_cast<std::uint16_t>(value >> 16));
+}
+
+bool Replay::readU16(std::uint16_t& value) {
+    if (cursor + 2 > data.size()) return false;
+    value = static_cast<std::uint16_t>(data[cursor] | (data[cursor + 1] << 8));
+    cursor += 2;
+    return true;
+}
+
+bool Replay::readU32(std::uint32_t& value) {
+    std::uint16_t lo = 0, hi = 0;
+    if (!readU16(lo) || !readU16(hi)) return false;
+    value = static_cast<std::uint32_t>(lo) | (static_cast<std::uint32_t>(hi) << 16);
+    return true;
+}
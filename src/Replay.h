@@ -0,0 +1,63 @@
+#pragma once
+
+#include <SDL.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Records what the simulation reads from the outside world each fixed tick
+// (movement keys, world-space aim point, viewport size, buff picks) so a run
+// can be fed back through Game::update and reproduce the same state.
+class Replay {
+public:
+    enum class Mode { Off, Recording, Playing };
+
+    ~Replay();
+
+    bool startRecording(const std::string& path, std::uint32_t seed);
+    bool startPlayback(const std::string& path);
+    void stop();
+
+    Mode getMode() const { return mode; }
+    bool isRecording() const { return mode == Mode::Recording; }
+    bool isPlaying() const { return mode == Mode::Playing; }
+    std::uint32_t getSeed() const { return seed; }
+    std::uint64_t getTickCount() const { return tickCount; }
+
+    void recordTick(const Uint8* keyboardState, int mouseX, int mouseY, int viewWidth, int viewHeight);
+    void recordBuffChoice(int index);
+
+    // Consumes a buff pick if it is the next thing in the stream.
+    bool nextBuffChoice(int& index);
+    // Applies the next tick's input. Returns false once the stream is exhausted.
+    bool nextTick(int& mouseX, int& mouseY);
+
+    const Uint8* getKeyboardState() const { return keys.data(); }
+    int getViewWidth() const { return viewWidth; }
+    int getViewHeight() const { return viewHeight; }
+
+private:
+    Mode mode = Mode::Off;
+    std::uint32_t seed = 0;
+    std::uint64_t tickCount = 0;
+
+    std::ofstream out;
+    std::string outPath;
+
+    std::vector<std::uint8_t> data;
+    std::size_t cursor = 0;
+
+    std::array<Uint8, SDL_NUM_SCANCODES> keys{};
+    int lastMouseX = 0;
+    int lastMouseY = 0;
+    int viewWidth = 0;
+    int viewHeight = 0;
+
+    void writeU16(std::uint16_t value);
+    void writeU32(std::uint32_t value);
+    bool readU16(std::uint16_t& value);
+    bool readU32(std::uint32_t& value);
+};
@@ -2,6 +2,7 @@
 #include "game.h"          
 #include "ECS/Components.h"   
 #include "ECS/Player.h"       
+#include "map.h"
 #include <fstream>
 #include <sstream>
 #include <filesystem>         
@@ -24,7 +25,11 @@ std::string SaveLoadManager::getCurrentTimestamp() {
     auto now = std::chrono::system_clock::now();
     auto now_c = std::chrono::system_clock::to_time_t(now);
     std::tm now_tm;
+#ifdef _WIN32
     localtime_s(&now_tm, &now_c); 
+#else
+    localtime_r(&now_c, &now_tm);
+#endif
 
     std::ostringstream oss;
     oss << std::put_time(&now_tm, "%d%m%Y-%H%M%S");
@@ -360,6 +365,7 @@ bool SaveLoadManager::loadGameState(const std::string& filename) {
     loadFile.close();
 
     if (playerEntity->hasComponent<TransformComponent>()) {
+        playerEntity->getComponent<TransformComponent>().resetInterpolation();
 
         int currentWindowWidth = WINDOW_WIDTH, currentWindowHeight = WINDOW_HEIGHT; 
         if(Game::renderer) { SDL_GetRendererOutputSize(Game::renderer, &currentWindowWidth, &currentWindowHeight); }
@@ -369,8 +375,9 @@ bool SaveLoadManager::loadGameState(const std::string& filename) {
         Game::camera.x = static_cast<int>(playerEntity->getComponent<TransformComponent>().position.x - (Game::camera.w / 2.0f));
         Game::camera.y = static_cast<int>(playerEntity->getComponent<TransformComponent>().position.y - (Game::camera.h / 2.0f));
 
-        int mapPixelWidth = MAP_WIDTH * TILE_SIZE; 
-        int mapPixelHeight = MAP_HEIGHT * TILE_SIZE; 
+        Map* map = gameInstance ? gameInstance->getMap() : nullptr;
+        int mapPixelWidth = map ? map->getPixelWidth() : MAP_WIDTH * TILE_SIZE; 
+        int mapPixelHeight = map ? map->getPixelHeight() : MAP_HEIGHT * TILE_SIZE; 
         Game::camera.x = std::max(0, std::min(Game::camera.x, mapPixelWidth - Game::camera.w));
         Game::camera.y = std::max(0, std::min(Game::camera.y, mapPixelHeight - Game::camera.h));
 
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <sstream>
 
+#include "../TextTextureCache.h"
 #include "../TextureManager.h"
 #include "../constants.h"
 #include "GameScene.h"
@@ -182,6 +183,11 @@ void MenuScene::clean() {
         fullscreenTextTex = nullptr;
     }
 
+    TextTextureCache& textCache = TextTextureCache::shared();
+    for (TTF_Font* f : {inputFont, saveSlotFont, uiHintFont}) {
+        if (f) textCache.purgeFont(f);
+    }
+
     if (inputFont) {
         TTF_CloseFont(inputFont);
         inputFont = nullptr;
@@ -827,79 +833,39 @@ void MenuScene::render() {
                                        ? saveSlotTextColorSelected
                                        : saveSlotTextColorDefault;
 
+            auto saveSlotTextRect = [&](int w, int h) {
+                SDL_Rect rect;
+                rect.w = static_cast<int>(w * saveSlotTextScale);
+                rect.h = static_cast<int>(h * saveSlotTextScale);
+                rect.x = currentSlotRect.x + (currentSlotRect.w - rect.w) / 2;
+                rect.y = currentSlotRect.y + (currentSlotRect.h - rect.h) / 2;
+                return rect;
+            };
+
             if (actualIndex == selectedSaveSlotIndex) {
 
                 SDL_Color outlineColor = {0, 0, 0, 255};
                 int outlineWidth = 1;
 
-                SDL_Surface* outlineSurface = TTF_RenderText_Blended(saveSlotFont, textStrToRender.c_str(), outlineColor);
-                SDL_Texture* outlineTexture = nullptr;
-                if (outlineSurface) {
-                    outlineTexture = SDL_CreateTextureFromSurface(Game::renderer, outlineSurface);
-                    SDL_FreeSurface(outlineSurface);
-                } else {
-                    std::cerr << "Failed to render outline text surface for save slot: " << textStrToRender << std::endl; 
-                }
-
-                SDL_Surface* mainSurface = TTF_RenderText_Blended(saveSlotFont, textStrToRender.c_str(), colorToUse);
-                SDL_Texture* mainTexture = nullptr;
-                SDL_Rect textDestRect = {0,0,0,0}; 
-                if (mainSurface) {
-                     mainTexture = SDL_CreateTextureFromSurface(Game::renderer, mainSurface);
-                    if (mainTexture) {
-
-                        textDestRect.w = static_cast<int>(mainSurface->w * saveSlotTextScale);
-                        textDestRect.h = static_cast<int>(mainSurface->h * saveSlotTextScale);
-                        textDestRect.x = currentSlotRect.x + (currentSlotRect.w - textDestRect.w) / 2;
-                        textDestRect.y = currentSlotRect.y + (currentSlotRect.h - textDestRect.h) / 2;
-                    } else {
-                         std::cerr << "Failed to create main texture for save slot text: " << textStrToRender << std::endl; 
-                    }
-                     SDL_FreeSurface(mainSurface);
-                } else {
-                    std::cerr << "Failed to render main text surface for save slot: " << textStrToRender << std::endl; 
-                }
-
-                if (outlineTexture && textDestRect.w > 0) {
+                const TextTextureCache::Entry* outline = TextTextureCache::shared().get(Game::renderer, saveSlotFont, textStrToRender, outlineColor);
+                if (outline) {
+                    SDL_Rect textDestRect = saveSlotTextRect(outline->width, outline->height);
                     for (int dy = -outlineWidth; dy <= outlineWidth; ++dy) {
                         for (int dx = -outlineWidth; dx <= outlineWidth; ++dx) {
                             if (dx == 0 && dy == 0) continue;
                             SDL_Rect outlineDest = textDestRect;
                             outlineDest.x += dx;
                             outlineDest.y += dy;
-                            SDL_RenderCopy(Game::renderer, outlineTexture, NULL, &outlineDest);
+                            TextureManager::RenderCopy(Game::renderer, outline->texture, NULL, &outlineDest);
                         }
                     }
-                     SDL_DestroyTexture(outlineTexture);
-                }
-
-                if (mainTexture && textDestRect.w > 0) {
-                    SDL_RenderCopy(Game::renderer, mainTexture, NULL, &textDestRect);
-                    SDL_DestroyTexture(mainTexture);
                 }
+            }
 
-            } else {
-
-                 SDL_Surface* surface = TTF_RenderText_Blended(saveSlotFont, textStrToRender.c_str(), colorToUse);
-                 if (surface) {
-                     SDL_Texture* textTexture = SDL_CreateTextureFromSurface(Game::renderer, surface);
-                     if (textTexture) {
-                         SDL_Rect textDestRect;
-
-                         textDestRect.w = static_cast<int>(surface->w * saveSlotTextScale);
-                         textDestRect.h = static_cast<int>(surface->h * saveSlotTextScale);
-                         textDestRect.x = currentSlotRect.x + (currentSlotRect.w - textDestRect.w) / 2;
-                         textDestRect.y = currentSlotRect.y + (currentSlotRect.h - textDestRect.h) / 2;
-
-                         SDL_RenderCopy(Game::renderer, textTexture, NULL, &textDestRect);
-                         SDL_DestroyTexture(textTexture);
-                     } else {
-                          std::cerr << "Failed to create texture for save slot text: " << textStrToRender << std::endl; 
-                     }
-                      SDL_FreeSurface(surface);
-                 } else {
-                      std::cerr << "Failed to render text surface for save slot: " << textStrToRender << std::endl; 
-                 }
+            const TextTextureCache::Entry* label = TextTextureCache::shared().get(Game::renderer, saveSlotFont, textStrToRender, colorToUse);
+            if (label) {
+                SDL_Rect textDestRect = saveSlotTextRect(label->width, label->height);
+                TextureManager::RenderCopy(Game::renderer, label->texture, NULL, &textDestRect);
             }
 
         } 
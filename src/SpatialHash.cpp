@@ -0,0 +1,57 @@
+#include "SpatialHash.h"
+#include <algorithm>
+
+SpatialHash::SpatialHash(int size) : cellSize(size > 0 ? size : 128) {}
+
+int SpatialHash::toCell(int coord) const {
+    return coord >= 0 ? coord / cellSize : -((-coord + cellSize - 1) / cellSize);
+}
+
+std::int64_t SpatialHash::cellKey(int cx, int cy) {
+    return (static_cast<std::int64_t>(cx) << 32) ^ static_cast<std::uint32_t>(cy);
+}
+
+void SpatialHash::clear() {
+    // Keep the buckets around so rebuilding every frame doesn't reallocate.
+    for (auto& cell : cells) cell.second.clear();
+}
+
+void SpatialHash::insert(int id, const SDL_Rect& rect) {
+    if (id < 0) return;
+    if (static_cast<std::size_t>(id) >= queryStamps.size()) {
+        queryStamps.resize(id + 1, 0);
+    }
+
+    int minX = toCell(rect.x), maxX = toCell(rect.x + rect.w);
+    int minY = toCell(rect.y), maxY = toCell(rect.y + rect.h);
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            cells[cellKey(cx, cy)].push_back(id);
+        }
+    }
+}
+
+void SpatialHash::query(const SDL_Rect& rect, std::vector<int>& outIds) {
+    outIds.clear();
+    if (++currentStamp == 0) {
+        std::fill(queryStamps.begin(), queryStamps.end(), 0);
+        currentStamp = 1;
+    }
+
+    int minX = toCell(rect.x), maxX = toCell(rect.x + rect.w);
+    int minY = toCell(rect.y), maxY = toCell(rect.y + rect.h);
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            auto it = cells.find(cellKey(cx, cy));
+            if (it == cells.end()) continue;
+            for (int id : it->second) {
+                if (queryStamps[id] == currentStamp) continue;
+                queryStamps[id] = currentStamp;
+                outIds.push_back(id);
+            }
+        }
+    }
+
+    // Callers rely on the same visiting order as a plain linear scan.
+    std::sort(outIds.begin(), outIds.end());
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class SpatialHash {
+public:
+    explicit SpatialHash(int cellSize = 128);
+
+    void clear();
+    void insert(int id, const SDL_Rect& rect);
+    void query(const SDL_Rect& rect, std::vector<int>& outIds);
+
+    int getCellSize() const { return cellSize; }
+
+private:
+    int cellSize;
+    std::unordered_map<std::int64_t, std::vector<int>> cells;
+    std::vector<std::uint32_t> queryStamps;
+    std::uint32_t currentStamp = 0;
+
+    int toCell(int coord) const;
+    static std::int64_t cellKey(int cx, int cy);
+};
@@ -0,0 +1,85 @@
+#include "SpriteBatch.h"
+#include "TextureManager.h"
+#include <cmath>
+
+void SpriteBatch::begin() {
+    reset();
+    open = true;
+}
+
+void SpriteBatch::reset() {
+    for (std::size_t i = 0; i < activeBuckets; ++i) {
+        buckets[i].vertices.clear();
+        buckets[i].indices.clear();
+    }
+    activeBuckets = 0;
+    quadCount = 0;
+}
+
+SpriteBatch::Bucket* SpriteBatch::bucketFor(SDL_Texture* texture) {
+    // A frame only uses a handful of textures, so a linear scan beats hashing.
+    for (std::size_t i = 0; i < activeBuckets; ++i) {
+        if (buckets[i].texture == texture) return &buckets[i];
+    }
+
+    int w = 0, h = 0;
+    if (SDL_QueryTexture(texture, NULL, NULL, &w, &h) != 0 || w <= 0 || h <= 0) return nullptr;
+
+    if (activeBuckets == buckets.size()) buckets.emplace_back();
+    Bucket& bucket = buckets[activeBuckets++];
+    bucket.texture = texture;
+    bucket.invWidth = 1.0f / w;
+    bucket.invHeight = 1.0f / h;
+    bucket.vertices.clear();
+    bucket.indices.clear();
+    return &bucket;
+}
+
+void SpriteBatch::add(SDL_Texture* texture, const SDL_Rect& src, const SDL_Rect& dest, double angle, SDL_RendererFlip flip, SDL_Color tint) {
+    if (!texture || dest.w <= 0 || dest.h <= 0) return;
+    Bucket* bucket = bucketFor(texture);
+    if (!bucket) return;
+
+    float u0 = src.x * bucket->invWidth, v0 = src.y * bucket->invHeight;
+    float u1 = (src.x + src.w) * bucket->invWidth, v1 = (src.y + src.h) * bucket->invHeight;
+    if (flip & SDL_FLIP_HORIZONTAL) std::swap(u0, u1);
+    if (flip & SDL_FLIP_VERTICAL) std::swap(v0, v1);
+
+    // Corners around the quad center, rotated clockwise like SDL_RenderCopyEx.
+    float halfW = dest.w * 0.5f, halfH = dest.h * 0.5f;
+    float cx = dest.x + halfW, cy = dest.y + halfH;
+    float c = 1.0f, s = 0.0f;
+    if (angle != 0.0) {
+        static const double PI = std::acos(-1.0);
+        double radians = angle * PI / 180.0;
+        c = static_cast<float>(std::cos(radians));
+        s = static_cast<float>(std::sin(radians));
+    }
+    const float cornerX[4] = {-halfW, halfW, halfW, -halfW};
+    const float cornerY[4] = {-halfH, -halfH, halfH, halfH};
+    const float cornerU[4] = {u0, u1, u1, u0};
+    const float cornerV[4] = {v0, v0, v1, v1};
+
+    SDL_Color color = {tint.r, tint.g, tint.b, 255};
+    int base = static_cast<int>(bucket->vertices.size());
+    for (int i = 0; i < 4; ++i) {
+        float x = cx + cornerX[i] * c - cornerY[i] * s;
+        float y = cy + cornerX[i] * s + cornerY[i] * c;
+        bucket->vertices.push_back(SDL_Vertex{SDL_FPoint{x, y}, color, SDL_FPoint{cornerU[i], cornerV[i]}});
+    }
+    bucket->indices.insert(bucket->indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    ++quadCount;
+}
+
+void SpriteBatch::flush(SDL_Renderer* renderer) {
+    if (renderer) {
+        for (std::size_t i = 0; i < activeBuckets; ++i) {
+            Bucket& bucket = buckets[i];
+            if (bucket.vertices.empty()) continue;
+            TextureManager::RenderGeometry(renderer, bucket.texture, bucket.vertices.data(), static_cast<int>(bucket.vertices.size()),
+                                           bucket.indices.data(), static_cast<int>(bucket.indices.size()));
+        }
+    }
+    reset();
+    open = false;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstddef>
+#include <vector>
+
+// Collects textured quads between begin() and flush() and submits them with one
+// SDL_RenderGeometry call per texture. Textures are flushed in the order they
+// were first added, so layers drawn in separate passes keep their stacking as
+// long as they don't share a texture.
+class SpriteBatch {
+public:
+    void begin();
+    void flush(SDL_Renderer* renderer);
+    bool isOpen() const { return open; }
+
+    // Same meaning as SDL_RenderCopyEx with a NULL center, plus a color mod.
+    void add(SDL_Texture* texture, const SDL_Rect& src, const SDL_Rect& dest, double angle, SDL_RendererFlip flip, SDL_Color tint);
+
+    std::size_t getQuadCount() const { return quadCount; }
+
+private:
+    struct Bucket {
+        SDL_Texture* texture = nullptr;
+        float invWidth = 0.0f;
+        float invHeight = 0.0f;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+    };
+
+    // Buckets past activeBuckets keep their storage for the next frame.
+    std::vector<Bucket> buckets;
+    std::size_t activeBuckets = 0;
+    std::size_t quadCount = 0;
+    bool open = false;
+
+    Bucket* bucketFor(SDL_Texture* texture);
+    void reset();
+};
@@ -0,0 +1,94 @@
+#include "TextTextureCache.h"
+#include "constants.h"
+#include <functional>
+#include <iostream>
+
+TextTextureCache& TextTextureCache::shared() {
+    static TextTextureCache cache(TEXT_CACHE_BUDGET_BYTES);
+    return cache;
+}
+
+TextTextureCache::TextTextureCache(std::size_t budgetBytes) : budget(budgetBytes) {}
+
+TextTextureCache::~TextTextureCache() {
+    clear();
+}
+
+std::size_t TextTextureCache::KeyHash::operator()(const Key& key) const {
+    std::size_t h = std::hash<std::string>()(key.text);
+    h ^= std::hash<const void*>()(key.font) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<Uint32>()(key.color) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<Uint32>()(key.wrapWidth) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+const TextTextureCache::Entry* TextTextureCache::get(SDL_Renderer* renderer, TTF_Font* font, const std::string& text, SDL_Color color, Uint32 wrapWidth) {
+    if (!renderer || !font || text.empty()) return nullptr;
+
+    Key key{font, text, (Uint32(color.r) << 24) | (Uint32(color.g) << 16) | (Uint32(color.b) << 8) | color.a, wrapWidth};
+    auto found = lookup.find(key);
+    if (found != lookup.end()) {
+        entries.splice(entries.begin(), entries, found->second);
+        return &found->second->entry;
+    }
+
+    SDL_Surface* surface = wrapWidth > 0 ? TTF_RenderText_Blended_Wrapped(font, text.c_str(), color, wrapWidth)
+                                         : TTF_RenderText_Blended(font, text.c_str(), color);
+    if (!surface) {
+        std::cerr << "TextTextureCache: Failed to render '" << text << "'. TTF_Error: " << TTF_GetError() << std::endl;
+        return nullptr;
+    }
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    Entry entry;
+    entry.texture = texture;
+    entry.width = surface->w;
+    entry.height = surface->h;
+    SDL_FreeSurface(surface);
+    if (!texture) {
+        std::cerr << "TextTextureCache: Failed to create texture for '" << text << "'. SDL_Error: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+
+    std::size_t bytes = static_cast<std::size_t>(entry.width) * entry.height * 4;
+    entries.push_front(Node{key, entry, bytes});
+    lookup.emplace(std::move(key), entries.begin());
+    bytesUsed += bytes;
+    evictOverBudget();
+    return &entries.front().entry;
+}
+
+void TextTextureCache::evictOverBudget() {
+    // The newest entry is always kept, even if it alone is over budget.
+    while (bytesUsed > budget && entries.size() > 1) {
+        erase(std::prev(entries.end()));
+    }
+}
+
+void TextTextureCache::erase(std::list<Node>::iterator it) {
+    if (it->entry.texture) SDL_DestroyTexture(it->entry.texture);
+    bytesUsed -= it->bytes;
+    lookup.erase(it->key);
+    entries.erase(it);
+}
+
+void TextTextureCache::purgeFont(TTF_Font* font) {
+    for (auto it = entries.begin(); it != entries.end();) {
+        auto next = std::next(it);
+        if (it->key.font == font) erase(it);
+        it = next;
+    }
+}
+
+void TextTextureCache::clear() {
+    for (auto& node : entries) {
+        if (node.entry.texture) SDL_DestroyTexture(node.entry.texture);
+    }
+    entries.clear();
+    lookup.clear();
+    bytesUsed = 0;
+}
+
+void TextTextureCache::setBudget(std::size_t budgetBytes) {
+    budget = budgetBytes;
+    evictOverBudget();
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// Retained text textures keyed by (font, string, color, wrap width), evicted
+// least-recently-used first once the estimated texture memory passes the budget.
+// A returned entry stays valid until the next call to get().
+class TextTextureCache {
+public:
+    struct Entry {
+        SDL_Texture* texture = nullptr;
+        int width = 0;
+        int height = 0;
+    };
+
+    static TextTextureCache& shared();
+
+    explicit TextTextureCache(std::size_t budgetBytes);
+    ~TextTextureCache();
+
+    TextTextureCache(const TextTextureCache&) = delete;
+    TextTextureCache& operator=(const TextTextureCache&) = delete;
+
+    // wrapWidth 0 renders a single line; otherwise TTF_RenderText_Blended_Wrapped.
+    const Entry* get(SDL_Renderer* renderer, TTF_Font* font, const std::string& text, SDL_Color color, Uint32 wrapWidth = 0);
+
+    // Must be called before a font is closed, since entries are keyed by its address.
+    void purgeFont(TTF_Font* font);
+    void clear();
+
+    void setBudget(std::size_t budgetBytes);
+    std::size_t getBytesUsed() const { return bytesUsed; }
+    std::size_t getEntryCount() const { return entries.size(); }
+
+private:
+    struct Key {
+        TTF_Font* font;
+        std::string text;
+        Uint32 color;
+        Uint32 wrapWidth;
+        bool operator==(const Key& other) const {
+            return font == other.font && color == other.color && wrapWidth == other.wrapWidth && text == other.text;
+        }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+    struct Node {
+        Key key;
+        Entry entry;
+        std::size_t bytes;
+    };
+
+    std::size_t budget;
+    std::size_t bytesUsed = 0;
+    // Most recently used at the front.
+    std::list<Node> entries;
+    std::unordered_map<Key, std::list<Node>::iterator, KeyHash> lookup;
+
+    void evictOverBudget();
+    void erase(std::list<Node>::iterator it);
+};
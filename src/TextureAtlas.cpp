@@ -0,0 +1,132 @@
+#include "TextureAtlas.h"
+#include "constants.h"
+#include <algorithm>
+#include <iostream>
+
+TextureAtlas::~TextureAtlas() {
+    destroy();
+}
+
+void TextureAtlas::add(const std::string& id, SDL_Surface* surface) {
+    if (!surface) return;
+    pending.push_back(Pending{id, surface});
+}
+
+void TextureAtlas::destroy() {
+    for (auto& item : pending) SDL_FreeSurface(item.surface);
+    pending.clear();
+    for (SDL_Texture* page : pages) SDL_DestroyTexture(page);
+    pages.clear();
+    for (SDL_Texture* texture : standalone) SDL_DestroyTexture(texture);
+    standalone.clear();
+    regions.clear();
+}
+
+bool TextureAtlas::find(const std::string& id, TextureRegion& region) const {
+    auto it = regions.find(id);
+    if (it == regions.end()) return false;
+    region = it->second;
+    return true;
+}
+
+bool TextureAtlas::build(SDL_Renderer* renderer, int maxPageSize) {
+    if (!renderer || pending.empty()) return false;
+
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0 && info.max_texture_height > 0) {
+        maxPageSize = std::min(maxPageSize, std::min(info.max_texture_width, info.max_texture_height));
+    }
+
+    std::stable_sort(pending.begin(), pending.end(), [](const Pending& a, const Pending& b) {
+        return a.surface->h > b.surface->h;
+    });
+
+    // Place every image first so each page can be allocated at its final height.
+    struct Placement {
+        std::size_t pending;
+        int page;
+        SDL_Rect rect;
+    };
+    std::vector<Placement> placements;
+    std::vector<int> pageHeights;
+    int shelfX = 0, shelfY = 0, shelfHeight = 0;
+    const int pad = TEXTURE_ATLAS_PADDING;
+
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        SDL_Surface* surface = pending[i].surface;
+        if (surface->w + 2 * pad > maxPageSize || surface->h + 2 * pad > maxPageSize) {
+            // Too big to share a page; it keeps a texture of its own.
+            SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+            if (!texture) {
+                std::cerr << "TextureAtlas: Failed to create texture for '" << pending[i].id << "'. SDL_Error: " << SDL_GetError() << std::endl;
+                continue;
+            }
+            standalone.push_back(texture);
+            TextureRegion region;
+            region.texture = texture;
+            region.rect = {0, 0, surface->w, surface->h};
+            regions[pending[i].id] = region;
+            continue;
+        }
+        if (pageHeights.empty()) pageHeights.push_back(0);
+
+        if (shelfX + surface->w + 2 * pad > maxPageSize) {
+            shelfY += shelfHeight;
+            shelfX = 0;
+            shelfHeight = 0;
+        }
+        if (shelfY + surface->h + 2 * pad > maxPageSize) {
+            pageHeights.push_back(0);
+            shelfX = shelfY = shelfHeight = 0;
+        }
+
+        int page = static_cast<int>(pageHeights.size()) - 1;
+        SDL_Rect rect = {shelfX + pad, shelfY + pad, surface->w, surface->h};
+        placements.push_back(Placement{i, page, rect});
+
+        shelfX += surface->w + 2 * pad;
+        shelfHeight = std::max(shelfHeight, surface->h + 2 * pad);
+        pageHeights[page] = std::max(pageHeights[page], shelfY + shelfHeight);
+    }
+
+    bool ok = true;
+    for (int page = 0; page < static_cast<int>(pageHeights.size()); ++page) {
+        SDL_Surface* pageSurface = SDL_CreateRGBSurfaceWithFormat(0, maxPageSize, pageHeights[page], 32, SDL_PIXELFORMAT_RGBA32);
+        if (!pageSurface) {
+            std::cerr << "TextureAtlas: Failed to create page surface. SDL_Error: " << SDL_GetError() << std::endl;
+            ok = false;
+            continue;
+        }
+
+        for (Placement& placement : placements) {
+            if (placement.page != page) continue;
+            SDL_Surface* surface = pending[placement.pending].surface;
+            // Copy the pixels as-is, alpha included, instead of blending onto the empty page.
+            SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+            SDL_Rect dst = placement.rect;
+            SDL_BlitSurface(surface, NULL, pageSurface, &dst);
+        }
+
+        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, pageSurface);
+        SDL_FreeSurface(pageSurface);
+        if (!texture) {
+            std::cerr << "TextureAtlas: Failed to create page texture. SDL_Error: " << SDL_GetError() << std::endl;
+            ok = false;
+            continue;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        pages.push_back(texture);
+
+        for (Placement& placement : placements) {
+            if (placement.page != page) continue;
+            TextureRegion region;
+            region.texture = texture;
+            region.rect = placement.rect;
+            regions[pending[placement.pending].id] = region;
+        }
+    }
+
+    for (auto& item : pending) SDL_FreeSurface(item.surface);
+    pending.clear();
+    return ok;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SDL.h>
+#include <map>
+#include <string>
+#include <vector>
+
+// A texture plus the part of it that holds one image. Images packed into an
+// atlas share their page texture; standalone textures cover the whole texture.
+struct TextureRegion {
+    SDL_Texture* texture = nullptr;
+    SDL_Rect rect = {0, 0, 0, 0};
+
+    explicit operator bool() const { return texture != nullptr; }
+};
+
+// Packs many small images into a few large page textures at load time, so
+// sprites that would each have their own texture can be drawn in one batch.
+// Images are placed on shelves, tallest first; anything larger than a page
+// keeps its own texture.
+class TextureAtlas {
+public:
+    TextureAtlas() = default;
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // Takes ownership of the surface. Images are only packed by build().
+    void add(const std::string& id, SDL_Surface* surface);
+    bool build(SDL_Renderer* renderer, int maxPageSize);
+    void destroy();
+
+    bool find(const std::string& id, TextureRegion& region) const;
+    std::size_t getPageCount() const { return pages.size(); }
+
+private:
+    struct Pending {
+        std::string id;
+        SDL_Surface* surface;
+    };
+
+    std::vector<Pending> pending;
+    std::vector<SDL_Texture*> pages;
+    // Images larger than a page.
+    std::vector<SDL_Texture*> standalone;
+    std::map<std::string, TextureRegion> regions;
+};
@@ -3,7 +3,13 @@
 #include <iostream> 
 #include <SDL.h>    
 
+Uint32 TextureManager::drawCallCount = 0;
+
 SDL_Texture* TextureManager::LoadTexture(const char* fileName) {
+    if (!Game::renderer) {
+        return nullptr;
+    }
+
     SDL_Surface *tmpSurface = IMG_Load(fileName);
 
     if (!tmpSurface) {
@@ -26,7 +32,7 @@ void TextureManager::Draw(SDL_Texture *tex, SDL_Rect src, SDL_Rect dest, double
     if (!Game::renderer || !tex) {
         return;
     }
-    SDL_RenderCopyEx(Game::renderer, tex, &src, &dest, angle, NULL, flip);
+    RenderCopyEx(Game::renderer, tex, &src, &dest, angle, NULL, flip);
 }
 
 void TextureManager::Draw(SDL_Texture *tex, SDL_Rect src, SDL_Rect dest, SDL_RendererFlip flip) {
@@ -34,5 +40,5 @@ void TextureManager::Draw(SDL_Texture *tex, SDL_Rect src, SDL_Rect dest, SDL_Ren
         return;
     }
 
-    SDL_RenderCopyEx(Game::renderer, tex, &src, &dest, 0.0, NULL, flip);
+    RenderCopyEx(Game::renderer, tex, &src, &dest, 0.0, NULL, flip);
 }
\ No newline at end of file
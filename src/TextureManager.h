@@ -8,4 +8,40 @@ class TextureManager {
         static SDL_Texture* LoadTexture(const char* fileName);
         static void Draw(SDL_Texture *tex, SDL_Rect src, SDL_Rect dest, double angle, SDL_RendererFlip flip);
         static void Draw(SDL_Texture *tex, SDL_Rect src, SDL_Rect dest, SDL_RendererFlip flip);
+
+        // Counted pass-throughs to the SDL render calls, used for the perf overlay.
+        static int RenderCopy(SDL_Renderer* rend, SDL_Texture* tex, const SDL_Rect* src, const SDL_Rect* dest) {
+            ++drawCallCount;
+            return SDL_RenderCopy(rend, tex, src, dest);
+        }
+        static int RenderCopyEx(SDL_Renderer* rend, SDL_Texture* tex, const SDL_Rect* src, const SDL_Rect* dest, double angle, const SDL_Point* center, SDL_RendererFlip flip) {
+            ++drawCallCount;
+            return SDL_RenderCopyEx(rend, tex, src, dest, angle, center, flip);
+        }
+        static int FillRect(SDL_Renderer* rend, const SDL_Rect* rect) {
+            ++drawCallCount;
+            return SDL_RenderFillRect(rend, rect);
+        }
+        static int FillRects(SDL_Renderer* rend, const SDL_Rect* rects, int count) {
+            ++drawCallCount;
+            return SDL_RenderFillRects(rend, rects, count);
+        }
+        static int DrawRect(SDL_Renderer* rend, const SDL_Rect* rect) {
+            ++drawCallCount;
+            return SDL_RenderDrawRect(rend, rect);
+        }
+        static int RenderGeometry(SDL_Renderer* rend, SDL_Texture* tex, const SDL_Vertex* vertices, int numVertices, const int* indices, int numIndices) {
+            ++drawCallCount;
+            return SDL_RenderGeometry(rend, tex, vertices, numVertices, indices, numIndices);
+        }
+        static int DrawLine(SDL_Renderer* rend, int x1, int y1, int x2, int y2) {
+            ++drawCallCount;
+            return SDL_RenderDrawLine(rend, x1, y1, x2, y2);
+        }
+
+        static Uint32 GetDrawCallCount() { return drawCallCount; }
+        static void ResetDrawCallCount() { drawCallCount = 0; }
+
+    private:
+        static Uint32 drawCallCount;
 };
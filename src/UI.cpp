@@ -3,6 +3,9 @@
 #include "Vector2D.h"
 #include "ECS/Player.h" 
 #include "ECS/Components.h" 
+#include "TextureManager.h"
+#include "TextTextureCache.h"
+#include "constants.h"
 #include <iostream>
 #include <iomanip>      
 #include <sstream>      
@@ -20,6 +23,12 @@ UIManager::UIManager(SDL_Renderer* rend) : renderer(rend), font(nullptr), largeF
 
 UIManager::~UIManager() {
     clearCache(); 
+    glyphAtlases.clear();
+
+    TextTextureCache& textCache = TextTextureCache::shared();
+    for (TTF_Font* f : {font, largeFont, uiFont, uiHeaderFont, bossHealthFont}) {
+        if (f) textCache.purgeFont(f);
+    }
 
     if (font) { TTF_CloseFont(font); font = nullptr; }
     if (largeFont) { TTF_CloseFont(largeFont); largeFont = nullptr; }
@@ -33,6 +42,7 @@ UIManager::~UIManager() {
 }
 
 void UIManager::init() {
+    if (!renderer) return;
 
     font = TTF_OpenFont("assets/font.ttf", 14);
     largeFont = TTF_OpenFont("assets/font.ttf", 20);
@@ -59,6 +69,17 @@ void UIManager::init() {
          std::cerr << "UI Warning: One or more essential fonts failed to load, UI text may not display correctly." << std::endl;
     }
 
+    glyphAtlases.clear();
+    for (TTF_Font* f : {font, largeFont, uiFont, uiHeaderFont, bossHealthFont}) {
+        if (!f || glyphAtlases.count(f)) continue;
+        std::unique_ptr<GlyphAtlas> atlas(new GlyphAtlas());
+        if (atlas->build(renderer, f)) {
+            glyphAtlases.emplace(f, std::move(atlas));
+        } else {
+            std::cerr << "UI Warning: Failed to build glyph atlas, falling back to per-string text rendering." << std::endl;
+        }
+    }
+
     if (Game::instance && Game::instance->assets) {
         weaponIconTex = Game::instance->assets->GetTexture("weapon_icon");
         fireIconTex = Game::instance->assets->GetTexture("fire_icon");
@@ -106,17 +127,25 @@ SDL_Texture* UIManager::renderTextToTexture(const std::string& text, SDL_Color c
     return texture;
 }
 
+GlyphAtlas* UIManager::getGlyphAtlas(TTF_Font* fontToUse, const std::string& text) {
+    auto it = glyphAtlases.find(fontToUse);
+    if (it == glyphAtlases.end() || !it->second->canDraw(text)) return nullptr;
+    return it->second.get();
+}
+
 void UIManager::drawText(const std::string& text, int x, int y, SDL_Color color, TTF_Font* fontToUse) {
     if (!fontToUse) fontToUse = uiFont;
     if (!fontToUse || !renderer) return;
 
-    int textWidth = 0, textHeight = 0;
-    SDL_Texture* textTexture = renderTextToTexture(text, color, fontToUse, textWidth, textHeight);
+    if (GlyphAtlas* atlas = getGlyphAtlas(fontToUse, text)) {
+        atlas->drawText(renderer, text, x, y, color);
+        return;
+    }
 
-    if (textTexture) {
-        SDL_Rect renderQuad = {x, y, textWidth, textHeight};
-        SDL_RenderCopy(renderer, textTexture, NULL, &renderQuad);
-        SDL_DestroyTexture(textTexture);
+    const TextTextureCache::Entry* cached = TextTextureCache::shared().get(renderer, fontToUse, text, color);
+    if (cached) {
+        SDL_Rect renderQuad = {x, y, cached->width, cached->height};
+        TextureManager::RenderCopy(renderer, cached->texture, NULL, &renderQuad);
     }
 }
 
@@ -124,20 +153,24 @@ void UIManager::drawTextWithOutline(const std::string& text, int x, int y, SDL_C
     if (!fontToUse) fontToUse = uiFont;
     if (!fontToUse || !renderer || outlineWidth < 1) return;
 
-    int olWidth = 0, olHeight = 0;
-    SDL_Texture* outlineTexture = renderTextToTexture(text, outlineColor, fontToUse, olWidth, olHeight);
-    if (!outlineTexture) return;
+    if (GlyphAtlas* atlas = getGlyphAtlas(fontToUse, text)) {
+        atlas->drawTextWithOutline(renderer, text, x, y, textColor, outlineColor, outlineWidth);
+        return;
+    }
+
+    const TextTextureCache::Entry* outline = TextTextureCache::shared().get(renderer, fontToUse, text, outlineColor);
+    if (!outline) return;
+    SDL_Texture* outlineTexture = outline->texture;
 
-    SDL_Rect dst = { 0, 0, olWidth, olHeight };
+    SDL_Rect dst = { 0, 0, outline->width, outline->height };
     for (int dy = -outlineWidth; dy <= outlineWidth; ++dy) {
         for (int dx = -outlineWidth; dx <= outlineWidth; ++dx) {
             if (dx == 0 && dy == 0) continue;
             dst.x = x + dx;
             dst.y = y + dy;
-            SDL_RenderCopy(renderer, outlineTexture, NULL, &dst);
+            TextureManager::RenderCopy(renderer, outlineTexture, NULL, &dst);
         }
     }
-    SDL_DestroyTexture(outlineTexture);
 
     drawText(text, x, y, textColor, fontToUse);
 }
@@ -154,10 +187,10 @@ void UIManager::renderPlayerHealthBar(Player* player, int& yPos) {
 
     SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255); 
     SDL_Rect bgRect = {xPos - 1, yPos - 1, HEALTH_BAR_WIDTH + 2, HEALTH_BAR_HEIGHT + 2};
-    SDL_RenderFillRect(renderer, &bgRect);
+    TextureManager::FillRect(renderer, &bgRect);
 
     SDL_SetRenderDrawColor(renderer, 180, 180, 180, 255); 
-    SDL_RenderDrawRect(renderer, &bgRect);
+    TextureManager::DrawRect(renderer, &bgRect);
 
     int maxHP = player->getMaxHealth();
     float healthPercent = (maxHP > 0) ? static_cast<float>(player->getHealth()) / maxHP : 0.0f;
@@ -165,7 +198,7 @@ void UIManager::renderPlayerHealthBar(Player* player, int& yPos) {
     int r = static_cast<int>(255 * (1.0f - healthPercent)); int g = static_cast<int>(255 * healthPercent);
     SDL_SetRenderDrawColor(renderer, r, g, 0, 255); 
     SDL_Rect healthRect = {xPos, yPos, currentBarWidth, HEALTH_BAR_HEIGHT};
-    SDL_RenderFillRect(renderer, &healthRect);
+    TextureManager::FillRect(renderer, &healthRect);
 
     std::stringstream ss; ss << player->getHealth() << "/" << maxHP;
     int textW = 0, textH = 0; TTF_SizeText(uiFont, ss.str().c_str(), &textW, &textH);
@@ -187,16 +220,16 @@ void UIManager::renderExpBar(Player* player, int& yPos) {
 
     SDL_SetRenderDrawColor(renderer, 30, 10, 40, 255); 
     SDL_Rect bgRect = {xPos - 1, yPos - 1, HEALTH_BAR_WIDTH + 2, HEALTH_BAR_HEIGHT + 2};
-    SDL_RenderFillRect(renderer, &bgRect);
+    TextureManager::FillRect(renderer, &bgRect);
 
     SDL_SetRenderDrawColor(renderer, 140, 80, 200, 255); 
-    SDL_RenderDrawRect(renderer, &bgRect);
+    TextureManager::DrawRect(renderer, &bgRect);
 
     float expPercent = player->getExperiencePercentage();
     int currentBarWidth = static_cast<int>(HEALTH_BAR_WIDTH * expPercent);
     SDL_SetRenderDrawColor(renderer, 130, 30, 240, 255); 
     SDL_Rect expRect = {xPos, yPos, currentBarWidth, HEALTH_BAR_HEIGHT};
-    SDL_RenderFillRect(renderer, &expRect);
+    TextureManager::FillRect(renderer, &expRect);
 
     std::stringstream ss_exp; ss_exp << player->getExperience() << "/" << player->getExperienceToNextLevel() << " EXP";
     int textW = 0, textH = 0; TTF_SizeText(uiFont, ss_exp.str().c_str(), &textW, &textH);
@@ -316,6 +349,7 @@ void UIManager::renderPlayerStats(Player* player, int& yPos) {
 }
 
 void UIManager::renderBossHealthBar() {
+    Entity* currentBossEntity = Game::instance ? Game::instance->manager.getEntity(currentBossHandle) : nullptr;
     if (!currentBossEntity || !currentBossEntity->isActive() || !currentBossEntity->hasComponent<HealthComponent>()) {
         return;
     }
@@ -338,16 +372,16 @@ void UIManager::renderBossHealthBar() {
 
     SDL_SetRenderDrawColor(renderer, 50, 10, 10, 200); 
     SDL_Rect bgRect = {barX - 2, barY - 2, barWidth + 4, barHeight + 4};
-    SDL_RenderFillRect(renderer, &bgRect);
+    TextureManager::FillRect(renderer, &bgRect);
 
     SDL_SetRenderDrawColor(renderer, 150, 40, 40, 255); 
-    SDL_RenderDrawRect(renderer, &bgRect);
+    TextureManager::DrawRect(renderer, &bgRect);
 
     float healthPercent = (maxHP > 0) ? static_cast<float>(currentHP) / maxHP : 0.0f;
     int currentBarWidth = static_cast<int>(barWidth * healthPercent);
     SDL_SetRenderDrawColor(renderer, 200, 0, 0, 255); 
     SDL_Rect healthRect = {barX, barY, currentBarWidth, barHeight}; 
-    SDL_RenderFillRect(renderer, &healthRect);
+    TextureManager::FillRect(renderer, &healthRect);
 
     std::stringstream ss; ss << "BOSS: " << currentHP << " / " << maxHP;
     int textW = 0, textH = 0; TTF_SizeText(fontToUse, ss.str().c_str(), &textW, &textH);
@@ -374,18 +408,125 @@ void UIManager::renderUI(Player* player) {
     renderPlayerStats(player, currentY);
 }
 
+void UIManager::tickFrameTimer() {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (frameTimesMs.empty()) frameTimesMs.assign(PERF_HISTORY_FRAMES, 0.0f);
+    if (lastFrameCounter != 0) {
+        float ms = static_cast<float>((now - lastFrameCounter) * 1000.0 / SDL_GetPerformanceFrequency());
+        frameTimesMs[frameTimeHead] = ms;
+        frameTimeHead = (frameTimeHead + 1) % PERF_HISTORY_FRAMES;
+        frameTimeCount = std::min(frameTimeCount + 1, PERF_HISTORY_FRAMES);
+        ++framesSincePerfTextRefresh;
+    }
+    lastFrameCounter = now;
+}
+
+void UIManager::setCachedText(TextCache& cache, const std::string& text, SDL_Color color, TTF_Font* fontToUse) {
+    if (cache.texture && cache.text == text) return;
+    if (cache.texture) { SDL_DestroyTexture(cache.texture); cache.texture = nullptr; }
+    cache.text = text;
+    cache.texture = renderTextToTexture(text, color, fontToUse, cache.width, cache.height);
+}
+
+void UIManager::renderPerfOverlay(const std::vector<std::pair<const char*, std::size_t>>& groupCounts, std::size_t entityCount, Uint32 drawCalls) {
+    if (!renderer || !uiFont || frameTimesMs.empty()) return;
+
+    const std::size_t fixedLines = 4;
+    if (perfOverlayText.size() != fixedLines + groupCounts.size()) {
+        perfOverlayText.clear();
+        perfOverlayText.resize(fixedLines + groupCounts.size());
+        lastPerfTextRefresh = 0;
+    }
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint64 refreshTicks = SDL_GetPerformanceFrequency() * PERF_TEXT_REFRESH_MS / 1000;
+    if (lastPerfTextRefresh == 0 || now - lastPerfTextRefresh >= refreshTicks) {
+        double elapsedMs = lastPerfTextRefresh ? (now - lastPerfTextRefresh) * 1000.0 / SDL_GetPerformanceFrequency() : 0.0;
+        double fps = elapsedMs > 0.0 ? framesSincePerfTextRefresh * 1000.0 / elapsedMs : 0.0;
+        lastPerfTextRefresh = now;
+        framesSincePerfTextRefresh = 0;
+
+        perfScratch.clear();
+        for (int i = 0; i < frameTimeCount; ++i) {
+            perfScratch.push_back(frameTimesMs[(frameTimeHead - 1 - i + PERF_HISTORY_FRAMES) % PERF_HISTORY_FRAMES]);
+        }
+        std::sort(perfScratch.begin(), perfScratch.end());
+        auto percentile = [&](float p) {
+            if (perfScratch.empty()) return 0.0f;
+            std::size_t index = static_cast<std::size_t>(p * (perfScratch.size() - 1) + 0.5f);
+            return perfScratch[index];
+        };
+
+        SDL_Color textColor = {230, 230, 230, 255};
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(1) << "FPS " << fps;
+        setCachedText(perfOverlayText[0], line.str(), textColor, uiFont);
+        line.str("");
+        line << "ms p50 " << percentile(0.5f) << "  p99 " << percentile(0.99f) << "  max " << (perfScratch.empty() ? 0.0f : perfScratch.back());
+        setCachedText(perfOverlayText[1], line.str(), textColor, uiFont);
+        line.str("");
+        line << "Draw calls " << drawCalls;
+        setCachedText(perfOverlayText[2], line.str(), textColor, uiFont);
+        line.str("");
+        line << "Entities " << entityCount;
+        setCachedText(perfOverlayText[3], line.str(), textColor, uiFont);
+        for (std::size_t i = 0; i < groupCounts.size(); ++i) {
+            line.str("");
+            line << "  " << groupCounts[i].first << " " << groupCounts[i].second;
+            setCachedText(perfOverlayText[fixedLines + i], line.str(), textColor, uiFont);
+        }
+    }
+
+    const int graphHeight = 60;
+    const float graphMaxMs = 50.0f;
+    int windowWidth = 0, windowHeight = 0;
+    SDL_GetRendererOutputSize(renderer, &windowWidth, &windowHeight);
+    int textHeight = 0;
+    for (const auto& cache : perfOverlayText) textHeight += cache.height;
+    SDL_Rect panel = {windowWidth - PERF_HISTORY_FRAMES - 2 * SECTION_PADDING, UI_PADDING, PERF_HISTORY_FRAMES + 2 * SECTION_PADDING, textHeight + graphHeight + 3 * SECTION_PADDING};
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 170);
+    TextureManager::FillRect(renderer, &panel);
+
+    int y = panel.y + SECTION_PADDING;
+    for (const auto& cache : perfOverlayText) {
+        if (cache.texture) {
+            SDL_Rect dst = {panel.x + SECTION_PADDING, y, cache.width, cache.height};
+            TextureManager::RenderCopy(renderer, cache.texture, NULL, &dst);
+        }
+        y += cache.height;
+    }
+
+    // Oldest sample on the left; the line marks the 60 Hz frame budget.
+    int graphBottom = y + SECTION_PADDING + graphHeight;
+    perfGraphBars.clear();
+    for (int i = 0; i < frameTimeCount; ++i) {
+        float ms = frameTimesMs[(frameTimeHead - frameTimeCount + i + PERF_HISTORY_FRAMES) % PERF_HISTORY_FRAMES];
+        int h = std::max(1, static_cast<int>(std::min(ms, graphMaxMs) / graphMaxMs * graphHeight));
+        perfGraphBars.push_back(SDL_Rect{panel.x + SECTION_PADDING + (PERF_HISTORY_FRAMES - frameTimeCount) + i, graphBottom - h, 1, h});
+    }
+    SDL_SetRenderDrawColor(renderer, 120, 220, 120, 255);
+    if (!perfGraphBars.empty()) TextureManager::FillRects(renderer, perfGraphBars.data(), static_cast<int>(perfGraphBars.size()));
+
+    int budgetY = graphBottom - static_cast<int>((1000.0f / FPS) / graphMaxMs * graphHeight);
+    SDL_SetRenderDrawColor(renderer, 220, 80, 80, 255);
+    TextureManager::DrawLine(renderer, panel.x + SECTION_PADDING, budgetY, panel.x + SECTION_PADDING + PERF_HISTORY_FRAMES, budgetY);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
+
 void UIManager::renderSimpleUI(Player* player) {
 
     if (!player || !renderer) return;
     int xPos = UI_PADDING; int yPos = UI_PADDING;
 
-    SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255); SDL_Rect bgRectH = {xPos - 1, yPos - 1, HEALTH_BAR_WIDTH + 2, HEALTH_BAR_HEIGHT + 2}; SDL_RenderFillRect(renderer, &bgRectH);
+    SDL_SetRenderDrawColor(renderer, 40, 40, 40, 255); SDL_Rect bgRectH = {xPos - 1, yPos - 1, HEALTH_BAR_WIDTH + 2, HEALTH_BAR_HEIGHT + 2}; TextureManager::FillRect(renderer, &bgRectH);
     float healthPercent = (player->getMaxHealth() > 0) ? static_cast<float>(player->getHealth()) / player->getMaxHealth() : 0.0f;
-    int currentBarWidthH = static_cast<int>(HEALTH_BAR_WIDTH * healthPercent); int r = static_cast<int>(255 * (1.0f - healthPercent)); int g = static_cast<int>(255 * healthPercent); SDL_SetRenderDrawColor(renderer, r, g, 0, 255); SDL_Rect healthRect = {xPos, yPos, currentBarWidthH, HEALTH_BAR_HEIGHT}; SDL_RenderFillRect(renderer, &healthRect);
+    int currentBarWidthH = static_cast<int>(HEALTH_BAR_WIDTH * healthPercent); int r = static_cast<int>(255 * (1.0f - healthPercent)); int g = static_cast<int>(255 * healthPercent); SDL_SetRenderDrawColor(renderer, r, g, 0, 255); SDL_Rect healthRect = {xPos, yPos, currentBarWidthH, HEALTH_BAR_HEIGHT}; TextureManager::FillRect(renderer, &healthRect);
     yPos += HEALTH_BAR_HEIGHT + SECTION_PADDING;
 
-    SDL_SetRenderDrawColor(renderer, 30, 10, 40, 255); SDL_Rect bgRectE = {xPos - 1, yPos - 1, HEALTH_BAR_WIDTH + 2, HEALTH_BAR_HEIGHT + 2}; SDL_RenderFillRect(renderer, &bgRectE);
-    float expPercent = player->getExperiencePercentage(); int currentBarWidthE = static_cast<int>(HEALTH_BAR_WIDTH * expPercent); SDL_SetRenderDrawColor(renderer, 130, 30, 240, 255); SDL_Rect expRect = {xPos, yPos, currentBarWidthE, HEALTH_BAR_HEIGHT}; SDL_RenderFillRect(renderer, &expRect);
+    SDL_SetRenderDrawColor(renderer, 30, 10, 40, 255); SDL_Rect bgRectE = {xPos - 1, yPos - 1, HEALTH_BAR_WIDTH + 2, HEALTH_BAR_HEIGHT + 2}; TextureManager::FillRect(renderer, &bgRectE);
+    float expPercent = player->getExperiencePercentage(); int currentBarWidthE = static_cast<int>(HEALTH_BAR_WIDTH * expPercent); SDL_SetRenderDrawColor(renderer, 130, 30, 240, 255); SDL_Rect expRect = {xPos, yPos, currentBarWidthE, HEALTH_BAR_HEIGHT}; TextureManager::FillRect(renderer, &expRect);
 }
 
 void UIManager::renderBuffSelectionUI(const std::vector<BuffInfo>& buffs, int windowWidth, int windowHeight) {
@@ -413,7 +554,7 @@ void UIManager::renderBuffSelectionUI(const std::vector<BuffInfo>& buffs, int wi
 
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
-    SDL_Rect fullscreen = {0, 0, windowWidth, windowHeight}; SDL_RenderFillRect(renderer, &fullscreen);
+    SDL_Rect fullscreen = {0, 0, windowWidth, windowHeight}; TextureManager::FillRect(renderer, &fullscreen);
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
     SDL_Color titleColor = {255, 215, 0, 255};
     int approxTitleWidth = static_cast<int>(300 * scaleFactor);
@@ -426,7 +567,7 @@ void UIManager::renderBuffSelectionUI(const std::vector<BuffInfo>& buffs, int wi
         int iconAreaX = currentX + (boxW - iconAreaSize) / 2;
         SDL_Rect iconBoundingBox = {iconAreaX, iconAreaY, iconAreaSize, iconAreaSize};
 
-        SDL_Texture* iconToDraw = defaultBuffIconTex;
+        TextureRegion iconToDraw = defaultBuffIconTex;
         SDL_Color buttonColor = defaultBuffColor;
         const BuffInfo& currentBuff = buffs[i];
         BuffType type = currentBuff.type;
@@ -439,19 +580,19 @@ void UIManager::renderBuffSelectionUI(const std::vector<BuffInfo>& buffs, int wi
 
         if (!iconToDraw) iconToDraw = defaultBuffIconTex; 
         if (iconToDraw) {
-            int texW, texH; SDL_QueryTexture(iconToDraw, NULL, NULL, &texW, &texH);
+            int texW = iconToDraw.rect.w, texH = iconToDraw.rect.h;
             float wScale = (texW > 0) ? (float)iconBoundingBox.w / texW : 1.0f; float hScale = (texH > 0) ? (float)iconBoundingBox.h / texH : 1.0f;
             float iconSpecificScale = std::min(wScale, hScale);
             int destW = static_cast<int>(texW * iconSpecificScale); int destH = static_cast<int>(texH * iconSpecificScale);
             int destX = iconBoundingBox.x + (iconBoundingBox.w - destW) / 2; int destY = iconBoundingBox.y + (iconBoundingBox.h - destH) / 2;
             SDL_Rect finalIconRect = {destX, destY, destW, destH};
-            SDL_RenderCopy(renderer, iconToDraw, NULL, &finalIconRect);
+            TextureManager::RenderCopy(renderer, iconToDraw.texture, &iconToDraw.rect, &finalIconRect);
          }
 
         SDL_SetRenderDrawColor(renderer, buttonColor.r, buttonColor.g, buttonColor.b, buttonColor.a);
-        SDL_RenderFillRect(renderer, &boxRect);
+        TextureManager::FillRect(renderer, &boxRect);
         SDL_SetRenderDrawColor(renderer, outlineColor.r, outlineColor.g, outlineColor.b, outlineColor.a);
-        SDL_RenderDrawRect(renderer, &boxRect);
+        TextureManager::DrawRect(renderer, &boxRect);
 
         int textPadding = std::max(2, static_cast<int>(5 * scaleFactor));
         int availableTextWidth = boxRect.w - 2 * textPadding;
@@ -473,76 +614,38 @@ void UIManager::renderBuffSelectionUI(const std::vector<BuffInfo>& buffs, int wi
         SDL_Color outlineColor = {0, 0, 0, 255}; 
         int outlineWidth = 1;                    
 
-        SDL_Surface* outlineSurface = TTF_RenderText_Blended_Wrapped(fontToUse, currentBuff.description.c_str(), outlineColor, availableTextWidth);
-        SDL_Texture* outlineTexture = nullptr;
-        if (outlineSurface) {
-            outlineTexture = SDL_CreateTextureFromSurface(renderer, outlineSurface);
-            if (!outlineTexture) {
-                std::cerr << "Failed to create texture for outline wrapped description! SDL Error: " << SDL_GetError() << std::endl; 
+        // Both passes share the same text and wrap width, so they have the same size.
+        TextTextureCache& textCache = TextTextureCache::shared();
+        Uint32 wrapWidth = static_cast<Uint32>(availableTextWidth);
+        const TextTextureCache::Entry* outline = textCache.get(renderer, fontToUse, currentBuff.description, outlineColor, wrapWidth);
+        if (!outline) continue;
+
+        SDL_Rect descriptionRect = {0, 0, outline->width, outline->height};
+        descriptionRect.x = boxRect.x + (boxRect.w - descriptionRect.w) / 2;
+        descriptionRect.y = currentTextY;
+
+        bool fitsVertically = (currentTextY + descriptionRect.h <= boxRect.y + boxRect.h - textPadding);
+        int renderHeight = fitsVertically ? descriptionRect.h : (boxRect.y + boxRect.h - textPadding - currentTextY);
+        if (renderHeight <= 0) continue;
+
+        SDL_Rect clippedSrcRect = {0, 0, descriptionRect.w, renderHeight};
+        SDL_Rect baseDestRect = descriptionRect;
+        baseDestRect.h = renderHeight;
+
+        for (int dy = -outlineWidth; dy <= outlineWidth; ++dy) {
+            for (int dx = -outlineWidth; dx <= outlineWidth; ++dx) {
+                if (dx == 0 && dy == 0) continue;
+                SDL_Rect outlineDestRect = baseDestRect;
+                outlineDestRect.x += dx;
+                outlineDestRect.y += dy;
+                TextureManager::RenderCopy(renderer, outline->texture, &clippedSrcRect, &outlineDestRect);
             }
-
-            SDL_FreeSurface(outlineSurface);
-        } else {
-             std::cerr << "Failed to render outline wrapped text surface! TTF_Error: " << TTF_GetError() << std::endl; 
         }
 
-        SDL_Surface* textSurface = TTF_RenderText_Blended_Wrapped(fontToUse, currentBuff.description.c_str(), descColor, availableTextWidth);
-        SDL_Texture* textTexture = nullptr;
-        SDL_Rect descriptionRect = {0, 0, 0, 0}; 
-
-        if (textSurface) {
-            textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-             if (textTexture) {
-                descriptionRect.w = textSurface->w;
-                descriptionRect.h = textSurface->h;
-
-                descriptionRect.x = boxRect.x + (boxRect.w - descriptionRect.w) / 2;
-
-                descriptionRect.y = currentTextY;
-             } else {
-                 std::cerr << "Failed to create texture for main wrapped description! SDL Error: " << SDL_GetError() << std::endl; 
-             }
-             SDL_FreeSurface(textSurface);
-        } else {
-             std::cerr << "Failed to render main wrapped text surface! TTF_Error: " << TTF_GetError() << std::endl; 
+        const TextTextureCache::Entry* main = textCache.get(renderer, fontToUse, currentBuff.description, descColor, wrapWidth);
+        if (main) {
+            TextureManager::RenderCopy(renderer, main->texture, &clippedSrcRect, &baseDestRect);
         }
-
-        if (outlineTexture && descriptionRect.w > 0 && descriptionRect.h > 0) {
-
-             bool fitsVertically = (currentTextY + descriptionRect.h <= boxRect.y + boxRect.h - textPadding);
-             int renderHeight = fitsVertically ? descriptionRect.h : (boxRect.y + boxRect.h - textPadding - currentTextY);
-             if (renderHeight > 0) {
-                 SDL_Rect clippedSrcRect = {0, 0, descriptionRect.w, renderHeight};
-                 SDL_Rect baseDestRect = descriptionRect; 
-                 baseDestRect.h = renderHeight;
-
-                 for (int dy = -outlineWidth; dy <= outlineWidth; ++dy) {
-                     for (int dx = -outlineWidth; dx <= outlineWidth; ++dx) {
-                         if (dx == 0 && dy == 0) continue; 
-                         SDL_Rect outlineDestRect = baseDestRect;
-                         outlineDestRect.x += dx;
-                         outlineDestRect.y += dy;
-                         SDL_RenderCopy(renderer, outlineTexture, &clippedSrcRect, &outlineDestRect);
-                     }
-                 }
-             }
-        }
-         if(outlineTexture) {
-              SDL_DestroyTexture(outlineTexture); 
-         }
-
-        if (textTexture && descriptionRect.w > 0 && descriptionRect.h > 0) {
-
-             bool fitsVertically = (currentTextY + descriptionRect.h <= boxRect.y + boxRect.h - textPadding);
-             int renderHeight = fitsVertically ? descriptionRect.h : (boxRect.y + boxRect.h - textPadding - currentTextY);
-             if (renderHeight > 0) {
-                 SDL_Rect clippedSrcRect = {0, 0, descriptionRect.w, renderHeight};
-                 SDL_Rect finalDestRect = descriptionRect; 
-                 finalDestRect.h = renderHeight;
-                 SDL_RenderCopy(renderer, textTexture, &clippedSrcRect, &finalDestRect);
-             }
-             SDL_DestroyTexture(textTexture); 
-            }
         }
     }
 }    
@@ -553,15 +656,9 @@ bool UIManager::isMouseInside(int mouseX, int mouseY, const SDL_Rect& rect) {
 }
 
 void UIManager::clearCache() { 
-    for (auto& cache : textCache) { 
-        if (cache.texture) {
-            SDL_DestroyTexture(cache.texture);
-            cache.texture = nullptr; 
-        }
-    }
-    textCache.clear(); 
+    perfOverlayText.clear();
 }
 
 void UIManager::setBossEntity(Entity* boss) {
-    currentBossEntity = boss;
+    currentBossHandle = boss ? boss->getHandle() : EntityHandle{};
 }
\ No newline at end of file
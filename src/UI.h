@@ -2,8 +2,15 @@
 
 #include <SDL.h>
 #include <SDL_ttf.h>
+#include <cstddef>
+#include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
+#include "ECS/ECS.h"
+#include "GlyphAtlas.h"
+#include "TextureAtlas.h"
 
 class Entity;
 class Vector2D;
@@ -14,7 +21,7 @@ class UIManager {
 private:
 
     SDL_Renderer* renderer;
-    Entity* currentBossEntity = nullptr; 
+    EntityHandle currentBossHandle; 
 
     TTF_Font* font = nullptr;       
     TTF_Font* largeFont = nullptr;    
@@ -22,13 +29,13 @@ private:
     TTF_Font* uiHeaderFont = nullptr; 
     TTF_Font* bossHealthFont = nullptr; 
 
-    SDL_Texture* weaponIconTex = nullptr;
-    SDL_Texture* fireIconTex = nullptr;
-    SDL_Texture* starIconTex = nullptr;
-    SDL_Texture* healthIconTex = nullptr;
-    SDL_Texture* lifestealIconTex = nullptr;
-    SDL_Texture* defaultBuffIconTex = nullptr;
-    SDL_Texture* maxHealthIconTex = nullptr; 
+    TextureRegion weaponIconTex;
+    TextureRegion fireIconTex;
+    TextureRegion starIconTex;
+    TextureRegion healthIconTex;
+    TextureRegion lifestealIconTex;
+    TextureRegion defaultBuffIconTex;
+    TextureRegion maxHealthIconTex; 
 
     struct TextCache {
         std::string text;
@@ -38,7 +45,25 @@ private:
         TextCache() : texture(nullptr), width(0), height(0) {}
         ~TextCache() { if (texture) SDL_DestroyTexture(texture); }
     };
-    std::vector<TextCache> textCache;
+
+    std::map<TTF_Font*, std::unique_ptr<GlyphAtlas>> glyphAtlases;
+    GlyphAtlas* getGlyphAtlas(TTF_Font* fontToUse, const std::string& text);
+
+    // Perf overlay. Text is rebuilt a few times a second and only re-rendered
+    // when a line changes; perfOverlayText is sized once so its entries never move.
+    static const int PERF_HISTORY_FRAMES = 240;
+    static const int PERF_TEXT_REFRESH_MS = 250;
+    std::vector<float> frameTimesMs;
+    int frameTimeHead = 0;
+    int frameTimeCount = 0;
+    Uint64 lastFrameCounter = 0;
+    Uint64 lastPerfTextRefresh = 0;
+    int framesSincePerfTextRefresh = 0;
+    std::vector<TextCache> perfOverlayText;
+    std::vector<float> perfScratch;
+    std::vector<SDL_Rect> perfGraphBars;
+
+    void setCachedText(TextCache& cache, const std::string& text, SDL_Color color, TTF_Font* fontToUse);
 
     const int HEALTH_BAR_WIDTH = 180;
     const int HEALTH_BAR_HEIGHT = 20;
@@ -82,6 +107,9 @@ public:
 
     void renderBuffSelectionUI(const std::vector<BuffInfo>& buffs, int windowWidth, int windowHeight);
 
+    void tickFrameTimer();
+    void renderPerfOverlay(const std::vector<std::pair<const char*, std::size_t>>& groupCounts, std::size_t entityCount, Uint32 drawCalls);
+
     bool isMouseInside(int mouseX, int mouseY, const SDL_Rect& rect);
     void clearCache(); 
     void setBossEntity(Entity* boss); 
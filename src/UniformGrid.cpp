@@ -0,0 +1,87 @@
+#include "UniformGrid.h"
+#include <algorithm>
+
+UniformGrid::UniformGrid(int size) : cellSize(size > 0 ? size : 128) {}
+
+void UniformGrid::reset(int worldWidth, int worldHeight) {
+    columns = std::max(1, (worldWidth + cellSize - 1) / cellSize);
+    rows = std::max(1, (worldHeight + cellSize - 1) / cellSize);
+    cells.resize(static_cast<std::size_t>(columns) * rows);
+    clear();
+}
+
+void UniformGrid::clear() {
+    // Keep each cell's storage so rebuilding every frame doesn't reallocate.
+    for (auto& cell : cells) cell.clear();
+}
+
+int UniformGrid::toColumn(int x) const {
+    return std::min(std::max(x / cellSize, 0), columns - 1);
+}
+
+int UniformGrid::toRow(int y) const {
+    return std::min(std::max(y / cellSize, 0), rows - 1);
+}
+
+void UniformGrid::insert(int id, const SDL_Rect& rect) {
+    if (id < 0 || cells.empty()) return;
+    if (static_cast<std::size_t>(id) >= queryStamps.size()) {
+        queryStamps.resize(id + 1, 0);
+    }
+
+    int minX = toColumn(rect.x), maxX = toColumn(rect.x + rect.w);
+    int minY = toRow(rect.y), maxY = toRow(rect.y + rect.h);
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            cells[cy * columns + cx].push_back(id);
+        }
+    }
+}
+
+void UniformGrid::query(const SDL_Rect& rect, std::vector<int>& outIds) {
+    outIds.clear();
+    if (cells.empty()) return;
+    if (++currentStamp == 0) {
+        std::fill(queryStamps.begin(), queryStamps.end(), 0);
+        currentStamp = 1;
+    }
+
+    int minX = toColumn(rect.x), maxX = toColumn(rect.x + rect.w);
+    int minY = toRow(rect.y), maxY = toRow(rect.y + rect.h);
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            for (int id : cells[cy * columns + cx]) {
+                if (queryStamps[id] == currentStamp) continue;
+                queryStamps[id] = currentStamp;
+                outIds.push_back(id);
+            }
+        }
+    }
+
+    // Ids are handed out in draw order, so sorting restores it.
+    std::sort(outIds.begin(), outIds.end());
+}
+
+void UniformGrid::queryPoints(const SDL_Rect& rect, std::vector<int>& outIds, std::size_t maxIds) const {
+    outIds.clear();
+    if (cells.empty() || maxIds == 0) return;
+
+    // The centre cell holds the closest points, so it gets the budget first.
+    int centre = toRow(rect.y + rect.h / 2) * columns + toColumn(rect.x + rect.w / 2);
+    auto take = [&](int index) {
+        const std::vector<int>& cell = cells[index];
+        std::size_t count = std::min(cell.size(), maxIds - outIds.size());
+        outIds.insert(outIds.end(), cell.begin(), cell.begin() + count);
+        return outIds.size() < maxIds;
+    };
+    if (!take(centre)) return;
+
+    int minX = toColumn(rect.x), maxX = toColumn(rect.x + rect.w);
+    int minY = toRow(rect.y), maxY = toRow(rect.y + rect.h);
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            int index = cy * columns + cx;
+            if (index != centre && !take(index)) return;
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+#include <vector>
+
+// Dense grid over a fixed world rectangle. Unlike SpatialHash there is no
+// hashing: a cell is an array index, which suits indexes rebuilt every frame
+// over a bounded area. Rects outside the bounds are clamped into the edge
+// cells, so callers should still do an exact test on what a query returns.
+class UniformGrid {
+public:
+    explicit UniformGrid(int cellSize = 128);
+
+    // Sizes the grid to cover (0, 0, worldWidth, worldHeight) and empties it.
+    void reset(int worldWidth, int worldHeight);
+    void clear();
+    void insert(int id, const SDL_Rect& rect);
+    void query(const SDL_Rect& rect, std::vector<int>& outIds);
+    // For grids filled with zero-size rects only: each id sits in one cell, so
+    // there is nothing to de-duplicate and several threads may query at once.
+    // Returns at most maxIds ids, unsorted: the cell under the rect's centre
+    // first, then the others row by row, each in insertion order.
+    void queryPoints(const SDL_Rect& rect, std::vector<int>& outIds, std::size_t maxIds) const;
+
+    int getCellSize() const { return cellSize; }
+
+private:
+    int cellSize;
+    int columns = 0;
+    int rows = 0;
+    std::vector<std::vector<int>> cells;
+    std::vector<std::uint32_t> queryStamps;
+    std::uint32_t currentStamp = 0;
+
+    int toColumn(int x) const;
+    int toRow(int y) const;
+};
@@ -9,6 +9,15 @@ const int WINDOW_HEIGHT = 600;
 const bool WINDOW_FULLSCREEN = false;
 const int FPS = 60;
 
+// --- Simulation Timing ---
+// The simulation always ticks at FPS; rendering runs as fast as the display allows.
+const double FIXED_TIMESTEP = 1.0 / FPS;
+const double MAX_FRAME_TIME = 0.25;
+const unsigned long long HEADLESS_DEFAULT_TICKS = 60ULL * 60 * 10;
+
+// --- Profiler ---
+const char* const PROFILER_TRACE_PATH = "profile_trace.json";
+
 // --- Character Settings ---
 const int CHAR_W = 64;
 const int CHAR_H = 64;
@@ -89,8 +98,60 @@ const char* const bossChargeSprite = "sprites/enemy/boss_charge.png";
 const char* const bossSlamSprite = "sprites/enemy/boss_slam.png";
 const char* const bossProjectileSprite = "sprites/projectile/boss_proj.png";
 
+// --- Texture Atlas ---
+const int TEXTURE_ATLAS_PAGE_SIZE = 2048;
+const int TEXTURE_ATLAS_PADDING = 1;
+
+// --- Text Texture Cache ---
+const size_t TEXT_CACHE_BUDGET_BYTES = 8 * 1024 * 1024;
+
+// --- Projectile Pool ---
+const int PROJECTILE_POOL_HIGH_WATER = 512;
+
 // --- Map Settings ---
 const int TILE_SIZE = 32;
 const int MAP_WIDTH = 80;
 const int MAP_HEIGHT = 50;
+const int MAP_CHUNK_TILES = 16;
+// Chunks this far past the view are decoded ahead on the streaming thread;
+// chunks further out than the keep radius are unloaded.
+const int MAP_STREAM_PREFETCH_CHUNKS = 1;
+const int MAP_STREAM_KEEP_CHUNKS = 2;
+// Enemies spawn at map spawn points within this many chunks of the view.
+const int MAP_SPAWN_RADIUS_CHUNKS = 2;
+
+// --- Enemy Navigation ---
+// Tiles the flow field search settles per update after the player changes tile.
+const int FLOW_FIELD_TILES_PER_UPDATE = 2048;
+// Enemies closer than this (centre to centre) push each other apart; each
+// enemy looks at no more than CROWD_MAX_NEIGHBORS candidates from the grid per
+// tick, in or out of range, so a packed horde stays linear.
+const int CROWD_SEPARATION_RADIUS = 48;
+const int CROWD_MAX_NEIGHBORS = 8;
+const float CROWD_SEPARATION_WEIGHT = 1.5f;
+const int CROWD_GRID_CELL_SIZE = 64;
+// AI level of detail, by how far outside the camera an enemy is. Near enemies
+// (on screen or within the near margin of it) think every tick; further tiers
+// think every N ticks and keep their last velocity in between. The near tier
+// must stay at one tick and cover the view, since contact damage is only
+// checked on thinking ticks; working from the camera rect keeps that true at
+// any window size.
+const int AI_LOD_TIER_COUNT = 3;
+const int AI_LOD_NEAR_MARGIN = 256;
+const int AI_LOD_MID_MARGIN = 1024;
+const int AI_LOD_NEAR_INTERVAL = 1;
+const int AI_LOD_MID_INTERVAL = 3;
+const int AI_LOD_FAR_INTERVAL = 8;
+
+// --- Job System ---
+const int JOB_SYSTEM_MAX_WORKERS = 8;
+// Enemies handed to one job at a time by the parallel AI and crowd passes.
+const int ENEMY_AI_JOB_GRAIN = 64;
+const int CROWD_JOB_GRAIN = 64;
+const int PROJECTILE_JOB_GRAIN = 128;
+const int ORB_JOB_GRAIN = 128;
+
+// --- Render Culling ---
+const int VISIBILITY_GRID_CELL_SIZE = 128;
+const int CULL_MARGIN = 32;
 const char* const MAP = "sprites/map/officialmap.png";
\ No newline at end of file
@@ -10,11 +10,13 @@
 #include "Collision.h"
 #include "AssetManager.h"
 #include "ECS/EnemyAi.h"
+#include <algorithm>
 #include <ctime>
 #include <vector>
 #include <cstdlib>
 #include <sstream>
 #include "SaveLoadManager.h"
+#include "Profiler.h"
 
 Game* Game::instance = nullptr;
 SDL_Event Game::event;
@@ -24,6 +26,22 @@ int Game::mouseY = 0;
 int Game::musicVolume = MIX_MAX_VOLUME / 2;
 int Game::sfxVolume = MIX_MAX_VOLUME / 2;
 SDL_Rect Game::camera = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+float Game::renderAlpha = 1.0f;
+bool Game::headless = false;
+bool Game::audioEnabled = true;
+const Uint8* Game::keyboardOverride = nullptr;
+Uint64 Game::simulationTicks = 0;
+Random Game::random;
+std::string Game::replayRecordPath;
+std::string Game::replayPlaybackPath;
+
+Uint32 Game::getTicks() {
+    return static_cast<Uint32>(simulationTicks * 1000 / FPS);
+}
+
+const Uint8* Game::getKeyboardState() {
+    return keyboardOverride ? keyboardOverride : SDL_GetKeyboardState(NULL);
+}
 bool Game::isRunning = false;
 
 Game::Game() {
@@ -31,7 +49,6 @@ Game::Game() {
         std::cerr << "Warning: Multiple Game instances detected!" << std::endl;
     }
     instance = this;
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
 
     playerEntity = nullptr;
     playerManager = nullptr;
@@ -51,7 +68,7 @@ Game::~Game(){
 }
 
 void Game::init(){
-    if (!Game::renderer) {
+    if (!Game::renderer && !headless) {
         std::cerr << "Error: Game::init called but Game::renderer is null!" << std::endl;
         isRunning = false;
         if(saveLoadManager) { delete saveLoadManager; saveLoadManager = nullptr; }
@@ -59,8 +76,17 @@ void Game::init(){
         return;
     }
 
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    if (renderer) SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
     currentState = GameState::Playing;
+    simulationTicks = 0;
+
+    Uint32 seed = static_cast<Uint32>(std::time(nullptr));
+    if (!replayPlaybackPath.empty() && replay.startPlayback(replayPlaybackPath)) {
+        seed = replay.getSeed();
+    } else if (!replayRecordPath.empty()) {
+        replay.startRecording(replayRecordPath, seed);
+    }
+    random.seed(seed);
 
     Mix_VolumeMusic(musicVolume);
     Mix_Volume(-1, sfxVolume);
@@ -69,22 +95,22 @@ void Game::init(){
     initializeEnemyDatabase();
 
     assets->AddTexture("terrain", MAP);
-    assets->AddTexture("player", playerSprites);
-
-    assets->AddTexture("projectile", "sprites/projectile/gunshot.png");
-    assets->AddTexture("fire", "sprites/projectile/fire.png");
-    assets->AddTexture("starproj", "sprites/projectile/star.png");
-
-    assets->AddTexture("exp_orb_1", "sprites/projectile/exp_orb1.png");
-    assets->AddTexture("exp_orb_10", "sprites/projectile/exp_orb10.png");
-    assets->AddTexture("exp_orb_50", "sprites/projectile/exp_orb50.png");
-    assets->AddTexture("exp_orb_100", "sprites/projectile/exp_orb100.png");
-    assets->AddTexture("exp_orb_200", "sprites/projectile/exp_orb200.png");
-    assets->AddTexture("exp_orb_500", "sprites/projectile/exp_orb500.png");
-    assets->AddTexture("boss_walk", bossWalkSprite);
-    assets->AddTexture("boss_charge", bossChargeSprite);
-    assets->AddTexture("boss_slam", bossSlamSprite);
-    assets->AddTexture("boss_projectile", bossProjectileSprite);
+    assets->AddAtlasTexture("player", playerSprites);
+
+    assets->AddAtlasTexture("projectile", "sprites/projectile/gunshot.png");
+    assets->AddAtlasTexture("fire", "sprites/projectile/fire.png");
+    assets->AddAtlasTexture("starproj", "sprites/projectile/star.png");
+
+    assets->AddAtlasTexture("exp_orb_1", "sprites/projectile/exp_orb1.png");
+    assets->AddAtlasTexture("exp_orb_10", "sprites/projectile/exp_orb10.png");
+    assets->AddAtlasTexture("exp_orb_50", "sprites/projectile/exp_orb50.png");
+    assets->AddAtlasTexture("exp_orb_100", "sprites/projectile/exp_orb100.png");
+    assets->AddAtlasTexture("exp_orb_200", "sprites/projectile/exp_orb200.png");
+    assets->AddAtlasTexture("exp_orb_500", "sprites/projectile/exp_orb500.png");
+    assets->AddAtlasTexture("boss_walk", bossWalkSprite);
+    assets->AddAtlasTexture("boss_charge", bossChargeSprite);
+    assets->AddAtlasTexture("boss_slam", bossSlamSprite);
+    assets->AddAtlasTexture("boss_projectile", bossProjectileSprite);
 
     assets->AddSoundEffect("gunshot_sound", "assets/sound/shot.wav");
     assets->AddMusic("level_music", "assets/sound/hlcbg.mp3");
@@ -101,27 +127,18 @@ void Game::init(){
     assets->AddSoundEffect("gameover_sfx", "assets/sound/gameover.wav");
     assets->AddSoundEffect("game_start", "assets/sound/start.wav");
     assets->AddSoundEffect("button_click", "assets/sound/buttonclick.wav");
-    assets->AddTexture("weapon_icon", "assets/menu/weaponicon.png");
-    assets->AddTexture("fire_icon", "assets/menu/fireicon.png");
-    assets->AddTexture("star_icon", "assets/menu/staricon.png");
-    assets->AddTexture("health_icon", "assets/menu/healthicon.png");
-    assets->AddTexture("lifesteal_icon", "assets/menu/lifestealicon.png");
+    assets->AddAtlasTexture("weapon_icon", "assets/menu/weaponicon.png");
+    assets->AddAtlasTexture("fire_icon", "assets/menu/fireicon.png");
+    assets->AddAtlasTexture("star_icon", "assets/menu/staricon.png");
+    assets->AddAtlasTexture("health_icon", "assets/menu/healthicon.png");
+    assets->AddAtlasTexture("lifesteal_icon", "assets/menu/lifestealicon.png");
 
-    int enemyTexFailed = 0;
     for (const auto& enemyData : allEnemyDatabase) {
-        if (!enemyData.sprite) continue;
-        SDL_Texture* loadedTexture = TextureManager::LoadTexture(enemyData.sprite);
-        if (loadedTexture == nullptr) {
-            enemyTexFailed++;
-            std::cerr << "ERROR: Failed to load texture for enemy: '" << enemyData.tag << "' path: " << enemyData.sprite << std::endl;
-        } else {
-            assets->AddTexture(enemyData.tag, enemyData.sprite); 
-            SDL_DestroyTexture(loadedTexture); 
-        }
-    }
-    if (enemyTexFailed > 0) {
-         std::cerr << "!!! ERROR: Failed to load one or more enemy textures. Check paths in constants.h and file existence. !!!" << std::endl;
+        if (!enemyData.sprite || !renderer) continue;
+        assets->AddAtlasTexture(enemyData.tag, enemyData.sprite);
     }
+    // Images that fail to decode are reported by id from here.
+    assets->BuildAtlas();
 
     delete ui;
     ui = new UIManager(renderer);
@@ -188,42 +205,49 @@ void Game::init(){
 
     delete map;
     map = new Map(manager, "terrain", 1, 32);
-    map->LoadMap("assets/map.map", MAP_WIDTH, MAP_HEIGHT, 10, spawnPoints);
-
-    pauseFont = TTF_OpenFont("assets/font.ttf", 10);
-    if (!pauseFont) {
-        std::cerr << "Failed to load pause font! SDL_ttf Error: " << TTF_GetError() << std::endl;
-        if(ui && ui->getFont()) pauseFont = ui->getFont(); 
-    }
-
-    pauseBoxTex = assets->GetTexture("pausebox");
-    buttonBoxTex = assets->GetTexture("buttonbox");
-    soundOnTex = assets->GetTexture("soundon");
-    soundOffTex = assets->GetTexture("soundoff");
-    sliderTrackTex = assets->GetTexture("slidebar");
-    sliderButtonTex = assets->GetTexture("slidebutton");
-
-    SDL_Color textColor = { 0, 0, 0, 255 };
-    continueTextTex = renderPauseText("Continue", textColor);
-    saveTextTex = renderPauseText("Save Game", textColor);
-    returnTextTex = renderPauseText("Return to Title", textColor);
+    map->LoadMap("assets/map.map", 10);
+    visibilityGrid.reset(map->getPixelWidth(), map->getPixelHeight());
+    flowField.reset(*map);
+    crowdSteering.reset(map->getPixelWidth(), map->getPixelHeight());
+    buildSimulationGraph();
+    simulationListsStale = true;
 
     isDraggingBgmPause = false;
     isDraggingSfxPause = false;
 
-    gameOverTex = assets->GetTexture("gameover");
-    gameOverFont = pauseFont; 
-    if (!gameOverFont) {
-         std::cerr << "Error: Font not available for Game Over text!" << std::endl;
-    } else {
-         SDL_Color goTextColor = { 255, 255, 255, 220 };
-         if (gameOverTextTex) { SDL_DestroyTexture(gameOverTextTex); gameOverTextTex = nullptr; }
-         SDL_Surface* surface = TTF_RenderText_Blended(gameOverFont, "Click anywhere to return to Title", goTextColor);
-         if(surface) {
-             gameOverTextTex = SDL_CreateTextureFromSurface(renderer, surface);
-             SDL_FreeSurface(surface);
-             if (!gameOverTextTex) { std::cerr << "Failed to create game over text texture!" << std::endl; }
-         } else { std::cerr << "Failed to render game over text surface!" << std::endl; }
+    if (renderer) {
+        pauseFont = TTF_OpenFont("assets/font.ttf", 10);
+        if (!pauseFont) {
+            std::cerr << "Failed to load pause font! SDL_ttf Error: " << TTF_GetError() << std::endl;
+            if(ui && ui->getFont()) pauseFont = ui->getFont(); 
+        }
+
+        pauseBoxTex = assets->GetTexture("pausebox").texture;
+        buttonBoxTex = assets->GetTexture("buttonbox").texture;
+        soundOnTex = assets->GetTexture("soundon").texture;
+        soundOffTex = assets->GetTexture("soundoff").texture;
+        sliderTrackTex = assets->GetTexture("slidebar").texture;
+        sliderButtonTex = assets->GetTexture("slidebutton").texture;
+
+        SDL_Color textColor = { 0, 0, 0, 255 };
+        continueTextTex = renderPauseText("Continue", textColor);
+        saveTextTex = renderPauseText("Save Game", textColor);
+        returnTextTex = renderPauseText("Return to Title", textColor);
+
+        gameOverTex = assets->GetTexture("gameover").texture;
+        gameOverFont = pauseFont; 
+        if (!gameOverFont) {
+             std::cerr << "Error: Font not available for Game Over text!" << std::endl;
+        } else {
+             SDL_Color goTextColor = { 255, 255, 255, 220 };
+             if (gameOverTextTex) { SDL_DestroyTexture(gameOverTextTex); gameOverTextTex = nullptr; }
+             SDL_Surface* surface = TTF_RenderText_Blended(gameOverFont, "Click anywhere to return to Title", goTextColor);
+             if(surface) {
+                 gameOverTextTex = SDL_CreateTextureFromSurface(renderer, surface);
+                 SDL_FreeSurface(surface);
+                 if (!gameOverTextTex) { std::cerr << "Failed to create game over text texture!" << std::endl; }
+             } else { std::cerr << "Failed to render game over text surface!" << std::endl; }
+        }
     }
 
     updateSpawnPoolAndWeights();
@@ -233,6 +257,9 @@ void Game::init(){
 void Game::clean(){
     std::cout << "Game::clean() called." << std::endl;
 
+    if (replay.isPlaying()) keyboardOverride = nullptr;
+    replay.stop();
+
     if (playerEntity) {
         playerEntity->destroy();
         playerEntity = nullptr;
@@ -259,6 +286,13 @@ void Game::handleEvents() {
         isRunning = false;
         return;
     }
+    if (Game::event.type == SDL_RENDER_TARGETS_RESET && map) {
+        map->bakeChunks();
+    }
+    if (Game::event.type == SDL_KEYDOWN && Game::event.key.keysym.sym == SDLK_F3) {
+        showPerfOverlay = !showPerfOverlay;
+        return;
+    }
 
     switch (currentState) {
         case GameState::Playing:
@@ -309,14 +343,42 @@ void Game::handleEvents() {
 }
 
 void Game::update(){
+    int buffIndex = 0;
+    if (isInBuffSelection && replay.nextBuffChoice(buffIndex)) {
+        applySelectedBuff(buffIndex);
+    }
     if (currentState != GameState::Playing) {
         return;
     }
     if (!isRunning || !playerEntity) return;
 
-    manager.refresh();
-    Uint32 currentTime = SDL_GetTicks();
-    manager.update();
+    PROFILE_SCOPE("Game::update");
+    advanceReplay();
+    ++simulationTicks;
+    {
+        PROFILE_SCOPE("Manager::refresh");
+        manager.refresh();
+    }
+    Uint32 currentTime = Game::getTicks();
+    {
+        PROFILE_SCOPE("updateFlowField");
+        updateFlowField();
+    }
+    {
+        PROFILE_SCOPE("Manager::update");
+        manager.update();
+    }
+    {
+        PROFILE_SCOPE("simulationGraph");
+        gatherSimulationLists();
+        simulationGraph.run(JobSystem::shared());
+    }
+    {
+        PROFILE_SCOPE("applySimulationResults");
+        applyEnemyContactDamage(currentTime);
+        destroyExpiredProjectiles();
+        collectTouchedOrbs();
+    }
 
     if (!playerEntity->hasComponent<ColliderComponent>() || !playerEntity->hasComponent<TransformComponent>() || !playerEntity->hasComponent<HealthComponent>()) {
          std::cerr << "Error in Game::update: Player missing required components!" << std::endl;
@@ -327,36 +389,75 @@ void Game::update(){
     HealthComponent& playerHealth = playerEntity->getComponent<HealthComponent>();
     SDL_Rect playerColRect = playerCollider.collider;
 
-    handleTerrainCollision(playerCollider, playerTransform, playerColRect);
-    handleProjectileCollisions(currentTime);
-    handleEnemySpawning(currentTime);
+    {
+        PROFILE_SCOPE("handleTerrainCollision");
+        handleTerrainCollision(playerCollider, playerTransform, playerColRect);
+    }
+    {
+        PROFILE_SCOPE("handleProjectileCollisions");
+        handleProjectileCollisions(currentTime);
+    }
+    {
+        PROFILE_SCOPE("handleEnemySpawning");
+        handleEnemySpawning(currentTime);
+    }
     updateCamera(playerTransform);
     checkPlayerDeath(playerHealth);
 }
 
 void Game::render(){
+    PROFILE_SCOPE("Game::render");
     if (!renderer) {
          std::cerr << "Error: Game::render called but renderer is null!" << std::endl;
          return;
     }
+    TextureManager::ResetDrawCallCount();
+    if (ui) ui->tickFrameTimer();
 
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     SDL_RenderClear(renderer);
 
     if (currentState == GameState::Playing || currentState == GameState::Paused || currentState == GameState::GameOver) {
+        // Nothing moves outside Playing, so blending would only make the frozen scene jitter.
+        if (currentState != GameState::Playing) renderAlpha = 1.0f;
 
-        for(auto* t : manager.getGroup(Game::groupMap)) if(t && t->isActive()) t->draw();
-        for(auto* o : manager.getGroup(Game::groupExpOrbs)) if(o && o->isActive()) o->draw();
-        for(auto* p : manager.getGroup(Game::groupProjectiles)) if(p && p->isActive()) p->draw();
-        for(auto* e : manager.getGroup(Game::groupEnemies)) if(e && e->isActive()) e->draw();
-        if(playerEntity && playerEntity->isActive()) playerEntity->draw();
-        for(auto* e : manager.getGroup(Game::groupEnemies)) {
-            if (e && e->isActive() && e->hasComponent<ColliderComponent>() && e->hasComponent<HealthComponent>() && !e->hasComponent<BossAIComponent>()) {
-                 renderHealthBar(*e, e->getComponent<ColliderComponent>().position);
+        // The world is drawn from an interpolated camera; the simulation camera is put back for the UI.
+        SDL_Rect simCamera = camera;
+        if (playerEntity && playerEntity->isActive() && playerEntity->hasComponent<TransformComponent>()) {
+            camera = cameraFor(playerEntity->getComponent<TransformComponent>().getRenderPosition(renderAlpha));
+        }
+
+        {
+            PROFILE_SCOPE("Map::draw");
+            if (map) {
+                map->updateStreaming(camera);
+                map->draw();
+            }
+        }
+        {
+            PROFILE_SCOPE("Draw entities");
+            collectVisibleEntities();
+            spriteBatch.begin();
+            for (int id : visibleDrawables) drawables[id]->draw();
+            if(playerEntity && playerEntity->isActive()) playerEntity->draw();
+            spriteBatch.flush(renderer);
+        }
+        for (int id : visibleDrawables) {
+            if (static_cast<std::size_t>(id) < firstEnemyDrawable) continue;
+            Entity* e = drawables[id];
+            if (e->hasComponent<ColliderComponent>() && e->hasComponent<HealthComponent>() && !e->hasComponent<BossAIComponent>()) {
+                 Vector2D barPos = e->getComponent<ColliderComponent>().position;
+                 if (e->hasComponent<TransformComponent>()) {
+                     const TransformComponent& t = e->getComponent<TransformComponent>();
+                     barPos += t.getRenderPosition(renderAlpha) - t.position;
+                 }
+                 renderHealthBar(*e, barPos);
             }
         }
+        camera = simCamera;
 
         if (currentState == GameState::Playing && ui && playerManager) {
+             PROFILE_SCOPE("UIManager::renderUI");
              ui->renderUI(playerManager);
         }
         else if (currentState == GameState::Paused) {
@@ -366,9 +467,72 @@ void Game::render(){
             renderGameOverState();
         }
     }
+    if (showPerfOverlay) renderPerfOverlay();
+    // Job counters cover one frame, like the draw call count.
+    JobSystem::shared().resetStats();
+    PROFILE_SCOPE("SDL_RenderPresent");
     SDL_RenderPresent(renderer);
 }
 
+void Game::collectVisibleEntities() {
+    PROFILE_SCOPE("Game::collectVisibleEntities");
+    drawables.clear();
+    drawableBounds.clear();
+    visibilityGrid.clear();
+
+    auto addGroup = [&](std::size_t group) {
+        for (auto* e : manager.getGroup(group)) {
+            if (!e || !e->isActive() || e->isParked() || !e->hasComponent<TransformComponent>()) continue;
+            const TransformComponent& t = e->getComponent<TransformComponent>();
+            Vector2D pos = t.getRenderPosition(renderAlpha);
+            SDL_Rect bounds = {static_cast<int>(pos.x), static_cast<int>(pos.y), t.width * t.scale, t.height * t.scale};
+            visibilityGrid.insert(static_cast<int>(drawables.size()), bounds);
+            drawables.push_back(e);
+            drawableBounds.push_back(bounds);
+        }
+    };
+    addGroup(Game::groupExpOrbs);
+    addGroup(Game::groupProjectiles);
+    firstEnemyDrawable = drawables.size();
+    addGroup(Game::groupEnemies);
+
+    // The margin covers spinning sprites and the health bars drawn above enemies.
+    SDL_Rect view = {camera.x - CULL_MARGIN, camera.y - CULL_MARGIN, camera.w + 2 * CULL_MARGIN, camera.h + 2 * CULL_MARGIN};
+    visibilityGrid.query(view, visibleDrawables);
+    visibleDrawables.erase(std::remove_if(visibleDrawables.begin(), visibleDrawables.end(), [&](int id) {
+        return !SDL_HasIntersection(&drawableBounds[id], &view);
+    }), visibleDrawables.end());
+}
+
+void Game::renderPerfOverlay() {
+    if (!ui) return;
+    static const char* const groupNames[] = {"Map", "Players", "Colliders", "Projectiles", "Enemies", "ExpOrbs"};
+    // Read before the overlay draws so it reports only the frame itself.
+    Uint32 drawCalls = TextureManager::GetDrawCallCount();
+
+    perfGroupCounts.clear();
+    for (std::size_t group = 0; group < sizeof(groupNames) / sizeof(groupNames[0]); ++group) {
+        std::size_t count = manager.getGroup(group).size();
+        perfGroupCounts.emplace_back(groupNames[group], count);
+    }
+
+    static const char* const lodNames[AI_LOD_TIER_COUNT] = {"AI near", "AI mid", "AI far"};
+    std::size_t lodCounts[AI_LOD_TIER_COUNT] = {};
+    for (auto* e : manager.getGroup(groupEnemies)) {
+        if (!e || !e->isActive() || !e->hasComponent<EnemyAIComponent>()) continue;
+        ++lodCounts[e->getComponent<EnemyAIComponent>().getLodTier()];
+    }
+    for (int tier = 0; tier < AI_LOD_TIER_COUNT; ++tier) {
+        perfGroupCounts.emplace_back(lodNames[tier], lodCounts[tier]);
+    }
+
+    JobSystem::Stats jobStats = JobSystem::shared().getStats();
+    perfGroupCounts.emplace_back("Jobs run", static_cast<std::size_t>(jobStats.tasksRun));
+    perfGroupCounts.emplace_back("Jobs stolen %", static_cast<std::size_t>(jobStats.tasksRun ? jobStats.tasksStolen * 100 / jobStats.tasksRun : 0));
+    perfGroupCounts.emplace_back("Job idle us", static_cast<std::size_t>(jobStats.idleMicroseconds));
+    ui->renderPerfOverlay(perfGroupCounts, manager.getActiveEntityCount(), drawCalls);
+}
+
 void Game::handlePauseMenuEvents() {
     int mouseX_Screen, mouseY_Screen;
     SDL_GetMouseState(&mouseX_Screen, &mouseY_Screen);
@@ -405,6 +569,7 @@ void Game::handlePauseMenuEvents() {
 }
 
 void Game::handleBuffSelectionEvents() {
+    if (replay.isPlaying()) return;
     SDL_Event& currentEvent = Game::event;
     if (currentEvent.type == SDL_MOUSEBUTTONDOWN && currentEvent.button.button == SDL_BUTTON_LEFT) {
         int mouseX_Screen, mouseY_Screen;
@@ -463,7 +628,7 @@ void Game::renderPausedState() {
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 50);
     SDL_Rect fullscreen = {0, 0, 0, 0};
     if(renderer) SDL_GetRendererOutputSize(renderer, &fullscreen.w, &fullscreen.h); else { fullscreen.w = 800; fullscreen.h = 600; }
-    SDL_RenderFillRect(renderer, &fullscreen);
+    TextureManager::FillRect(renderer, &fullscreen);
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
 
     int windowWidth, windowHeight;
@@ -485,29 +650,29 @@ void Game::renderPausedState() {
 }
 
 void Game::renderPauseMenuUI() {
-    if (pauseBoxTex) SDL_RenderCopy(renderer, pauseBoxTex, NULL, &pauseBoxRect);
+    if (pauseBoxTex) TextureManager::RenderCopy(renderer, pauseBoxTex, NULL, &pauseBoxRect);
     if (buttonBoxTex) {
-        SDL_RenderCopy(renderer, buttonBoxTex, NULL, &continueButtonRect);
-        SDL_RenderCopy(renderer, buttonBoxTex, NULL, &saveButtonRect);
-        SDL_RenderCopy(renderer, buttonBoxTex, NULL, &returnButtonRect);
+        TextureManager::RenderCopy(renderer, buttonBoxTex, NULL, &continueButtonRect);
+        TextureManager::RenderCopy(renderer, buttonBoxTex, NULL, &saveButtonRect);
+        TextureManager::RenderCopy(renderer, buttonBoxTex, NULL, &returnButtonRect);
     }
-    if (continueTextTex) SDL_RenderCopy(renderer, continueTextTex, NULL, &continueTextRect);
-    if (saveTextTex) SDL_RenderCopy(renderer, saveTextTex, NULL, &saveTextRect);
-    if (returnTextTex) SDL_RenderCopy(renderer, returnTextTex, NULL, &returnTextRect);
+    if (continueTextTex) TextureManager::RenderCopy(renderer, continueTextTex, NULL, &continueTextRect);
+    if (saveTextTex) TextureManager::RenderCopy(renderer, saveTextTex, NULL, &saveTextRect);
+    if (returnTextTex) TextureManager::RenderCopy(renderer, returnTextTex, NULL, &returnTextRect);
 
     SDL_Texture* bgmIcon = (Game::getMusicVolume() == 0) ? soundOffTex : soundOnTex;
     SDL_Texture* sfxIcon = (Game::getSfxVolume() == 0) ? soundOffTex : soundOnTex;
-    if (bgmIcon) SDL_RenderCopy(renderer, bgmIcon, NULL, &bgmIconRectPause);
-    if (sfxIcon) SDL_RenderCopy(renderer, sfxIcon, NULL, &sfxIconRectPause);
+    if (bgmIcon) TextureManager::RenderCopy(renderer, bgmIcon, NULL, &bgmIconRectPause);
+    if (sfxIcon) TextureManager::RenderCopy(renderer, sfxIcon, NULL, &sfxIconRectPause);
     if (sliderTrackTex) {
-      SDL_RenderCopy(renderer, sliderTrackTex, NULL, &bgmSliderTrackRectPause);
-      SDL_RenderCopy(renderer, sliderTrackTex, NULL, &sfxSliderTrackRectPause);
+      TextureManager::RenderCopy(renderer, sliderTrackTex, NULL, &bgmSliderTrackRectPause);
+      TextureManager::RenderCopy(renderer, sliderTrackTex, NULL, &sfxSliderTrackRectPause);
     }
     if (sliderButtonTex) {
         SDL_Color origColor; SDL_GetTextureColorMod(sliderButtonTex, &origColor.r, &origColor.g, &origColor.b);
         if(isDraggingBgmPause || isDraggingSfxPause) SDL_SetTextureColorMod(sliderButtonTex, 200, 200, 200);
-        SDL_RenderCopy(renderer, sliderButtonTex, NULL, &bgmSliderButtonRectPause);
-        SDL_RenderCopy(renderer, sliderButtonTex, NULL, &sfxSliderButtonRectPause);
+        TextureManager::RenderCopy(renderer, sliderButtonTex, NULL, &bgmSliderButtonRectPause);
+        TextureManager::RenderCopy(renderer, sliderButtonTex, NULL, &sfxSliderButtonRectPause);
         SDL_SetTextureColorMod(sliderButtonTex, origColor.r, origColor.g, origColor.b);
     }
 }
@@ -517,7 +682,7 @@ void Game::renderGameOverState() {
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
     SDL_Rect fullscreen = {0, 0, 0, 0};
     if(renderer) SDL_GetRendererOutputSize(renderer, &fullscreen.w, &fullscreen.h); else { fullscreen.w = 800; fullscreen.h = 600; }
-    SDL_RenderFillRect(renderer, &fullscreen);
+    TextureManager::FillRect(renderer, &fullscreen);
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
 
     if (gameOverTex) {
@@ -528,7 +693,7 @@ void Game::renderGameOverState() {
         gameOverRect.h = std::min(static_cast<int>(texH_orig * gameOverScale), windowH_render * 4/5 );
         gameOverRect.x = (windowW_render - gameOverRect.w) / 2;
         gameOverRect.y = (windowH_render - gameOverRect.h) / 3;
-        SDL_RenderCopy(renderer, gameOverTex, NULL, &gameOverRect);
+        TextureManager::RenderCopy(renderer, gameOverTex, NULL, &gameOverRect);
     }
     if (gameOverTextTex) {
         int textW_orig, textH_orig; SDL_QueryTexture(gameOverTextTex, NULL, NULL, &textW_orig, &textH_orig);
@@ -538,7 +703,7 @@ void Game::renderGameOverState() {
         int currentWindowWidth_text; SDL_GetRendererOutputSize(renderer, &currentWindowWidth_text, NULL);
         gameOverTextRect.x = (currentWindowWidth_text - gameOverTextRect.w) / 2;
         gameOverTextRect.y = gameOverRect.y + gameOverRect.h + 30;
-        SDL_RenderCopy(renderer, gameOverTextTex, NULL, &gameOverTextRect);
+        TextureManager::RenderCopy(renderer, gameOverTextTex, NULL, &gameOverTextRect);
     }
 }
 
@@ -556,46 +721,180 @@ void Game::renderHealthBar(Entity& entity, Vector2D position) {
 
     SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255); 
     SDL_Rect bgRect = {xPos - 1, yPos - 1, barWidth + 2, barHeight + 2};
-    SDL_RenderFillRect(renderer, &bgRect);
+    TextureManager::FillRect(renderer, &bgRect);
 
     float healthPercent = static_cast<float>(health.getHealth()) / health.getMaxHealth();
     int currentBarWidth = static_cast<int>(barWidth * healthPercent);
     int r = static_cast<int>(255 * (1.0f - healthPercent)); int g = static_cast<int>(255 * healthPercent);
     SDL_SetRenderDrawColor(renderer, r, g, 0, 255); 
     SDL_Rect healthRect = {xPos, yPos, currentBarWidth, barHeight};
-    SDL_RenderFillRect(renderer, &healthRect);
+    TextureManager::FillRect(renderer, &healthRect);
 }
 
 void Game::handleTerrainCollision(ColliderComponent& playerCollider, TransformComponent& playerTransform, SDL_Rect& playerColRect) {
-    for (auto* c : manager.getGroup(Game::groupColliders)) {
-        if (!c || !c->isActive() || !c->hasComponent<ColliderComponent>()) continue;
-        ColliderComponent& obstacleCollider = c->getComponent<ColliderComponent>();
-        if (obstacleCollider.tag != "terrain") continue;
-
-        SDL_Rect cCol = obstacleCollider.collider;
-        if (Collision::AABB(playerColRect, cCol)) {
-             Vector2D centerPlayer(playerColRect.x + playerColRect.w / 2.0f, playerColRect.y + playerColRect.h / 2.0f);
-             Vector2D centerObstacle(cCol.x + cCol.w / 2.0f, cCol.y + cCol.h / 2.0f);
-             float overlapX = (playerColRect.w / 2.0f + cCol.w / 2.0f) - std::abs(centerPlayer.x - centerObstacle.x);
-             float overlapY = (playerColRect.h / 2.0f + cCol.h / 2.0f) - std::abs(centerPlayer.y - centerObstacle.y);
-
-             if (overlapX > 0 && overlapY > 0) {
-                 if (overlapX < overlapY) {
-                     playerTransform.position.x += (centerPlayer.x < centerObstacle.x ? -overlapX : overlapX);
-                 } else {
-                     playerTransform.position.y += (centerPlayer.y < centerObstacle.y ? -overlapY : overlapY);
+    if (!map) return;
+
+    // A resolved overlap can push the player at most one tile, so a one-tile margin keeps every tile it could reach in view.
+    int minX, minY, maxX, maxY;
+    map->getTileRange(playerColRect, minX, minY, maxX, maxY);
+    for (int ty = minY - 1; ty <= maxY + 1; ++ty) {
+        for (int tx = minX - 1; tx <= maxX + 1; ++tx) {
+            if (!map->isSolid(tx, ty)) continue;
+
+            SDL_Rect cCol = map->getTileRect(tx, ty);
+            if (Collision::AABB(playerColRect, cCol)) {
+                 Vector2D centerPlayer(playerColRect.x + playerColRect.w / 2.0f, playerColRect.y + playerColRect.h / 2.0f);
+                 Vector2D centerObstacle(cCol.x + cCol.w / 2.0f, cCol.y + cCol.h / 2.0f);
+                 float overlapX = (playerColRect.w / 2.0f + cCol.w / 2.0f) - std::abs(centerPlayer.x - centerObstacle.x);
+                 float overlapY = (playerColRect.h / 2.0f + cCol.h / 2.0f) - std::abs(centerPlayer.y - centerObstacle.y);
+
+                 if (overlapX > 0 && overlapY > 0) {
+                     if (overlapX < overlapY) {
+                         playerTransform.position.x += (centerPlayer.x < centerObstacle.x ? -overlapX : overlapX);
+                     } else {
+                         playerTransform.position.y += (centerPlayer.y < centerObstacle.y ? -overlapY : overlapY);
+                     }
+                     playerCollider.update();
+                     playerColRect = playerCollider.collider; 
                  }
-                 playerCollider.update();
-                 playerColRect = playerCollider.collider; 
-             }
+            }
+        }
+    }
+}
+
+void Game::updateFlowField() {
+    if (!map || !playerEntity->hasComponent<ColliderComponent>()) return;
+    const SDL_Rect& playerColRect = playerEntity->getComponent<ColliderComponent>().collider;
+    int tileSize = map->getScaledSize();
+    flowField.update(*map, (playerColRect.x + playerColRect.w / 2) / tileSize, (playerColRect.y + playerColRect.h / 2) / tileSize);
+}
+
+void Game::buildSimulationGraph() {
+    // Enemies, projectiles and orbs touch disjoint components, so only crowd
+    // steering has to wait (for the velocities the AI picks). Anything that
+    // writes shared state is deferred to the apply step after run().
+    simulationGraph.clear();
+    int enemyAI = simulationGraph.add([this] { thinkEnemies(Game::getTicks()); });
+    int crowd = simulationGraph.add([this] { crowdSteering.update(crowdMembers); });
+    simulationGraph.precede(enemyAI, crowd);
+    simulationGraph.add([this] { moveProjectiles(); });
+    simulationGraph.add([this] { findTouchedOrbs(); });
+}
+
+void Game::gatherSimulationLists() {
+    // The passes below run as flat loops over these lists instead of
+    // re-checking every group member's components on each thread. A list is
+    // only gathered again once its group's membership has changed: entities
+    // are always dropped from their groups before refresh frees them, so an
+    // unchanged version means every cached pointer is still alive.
+    if (simulationListsStale || manager.getGroupVersion(groupEnemies) != enemyListVersion) {
+        enemyListVersion = manager.getGroupVersion(groupEnemies);
+        crowdMembers.clear();
+        manager.each<TransformComponent, ColliderComponent>([this](Entity& e, TransformComponent&, ColliderComponent&) {
+            if (e.hasGroup(groupEnemies)) crowdMembers.push_back(&e);
+        });
+        enemyBrains.clear();
+        manager.each<EnemyAIComponent>([this](Entity& e, EnemyAIComponent& ai) {
+            if (e.hasGroup(groupEnemies)) enemyBrains.push_back(&ai);
+        });
+    }
+    if (simulationListsStale || manager.getGroupVersion(groupProjectiles) != projectileListVersion) {
+        projectileListVersion = manager.getGroupVersion(groupProjectiles);
+        projectileMovers.clear();
+        manager.each<ProjectileComponent>([this](Entity& e, ProjectileComponent& projectile) {
+            if (e.hasGroup(groupProjectiles)) projectileMovers.push_back(&projectile);
+        });
+    }
+    if (simulationListsStale || manager.getGroupVersion(groupExpOrbs) != orbListVersion) {
+        orbListVersion = manager.getGroupVersion(groupExpOrbs);
+        expOrbs.clear();
+        manager.each<ExpOrbComponent>([this](Entity& e, ExpOrbComponent& orb) {
+            if (e.hasGroup(groupExpOrbs)) expOrbs.push_back(&orb);
+        });
+    }
+    simulationListsStale = false;
+}
+
+void Game::thinkEnemies(Uint32 currentTime) {
+    EnemyAIContext context;
+    context.currentTime = currentTime;
+    context.view = camera;
+    context.flowField = &flowField;
+    if (playerEntity && playerEntity->isActive() && playerEntity->hasComponent<TransformComponent>() && playerEntity->hasComponent<ColliderComponent>() && playerEntity->hasComponent<HealthComponent>()) {
+        context.playerValid = true;
+        context.playerPosition = playerEntity->getComponent<TransformComponent>().position;
+        context.playerCollider = playerEntity->getComponent<ColliderComponent>().collider;
+    }
+
+    // Each enemy writes only its own components and its own damage slot.
+    enemyContactDamage.assign(enemyBrains.size(), 0);
+    JobSystem::shared().parallelFor(enemyBrains.size(), ENEMY_AI_JOB_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!enemyBrains[i]->entity->isActive()) continue;
+            enemyContactDamage[i] = enemyBrains[i]->think(context);
+        }
+    });
+}
+
+void Game::applyEnemyContactDamage(Uint32 currentTime) {
+    // Applied in list order so the result never depends on which thread finished first.
+    if (!playerEntity || !playerEntity->isActive() || !playerEntity->hasComponent<HealthComponent>()) return;
+    for (int damage : enemyContactDamage) {
+        if (damage <= 0) continue;
+        playerEntity->getComponent<HealthComponent>().takeDamage(damage);
+        if (playerEntity->hasComponent<SpriteComponent>()) {
+            playerEntity->getComponent<SpriteComponent>().isHit = true;
+            playerEntity->getComponent<SpriteComponent>().hitTime = currentTime;
+        }
+    }
+}
+
+void Game::moveProjectiles() {
+    projectileExpired.assign(projectileMovers.size(), 0);
+    SDL_Rect view = camera;
+    JobSystem::shared().parallelFor(projectileMovers.size(), PROJECTILE_JOB_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!projectileMovers[i]->entity->isActive()) continue;
+            projectileExpired[i] = !projectileMovers[i]->advance(view);
         }
+    });
+}
+
+void Game::destroyExpiredProjectiles() {
+    for (std::size_t i = 0; i < projectileExpired.size(); ++i) {
+        if (projectileExpired[i]) projectileMovers[i]->entity->destroy();
+    }
+}
+
+void Game::findTouchedOrbs() {
+    orbTouched.assign(expOrbs.size(), 0);
+    if (!playerEntity || !playerEntity->isActive() || !playerEntity->hasComponent<ColliderComponent>()) return;
+    SDL_Rect playerColRect = playerEntity->getComponent<ColliderComponent>().collider;
+    JobSystem::shared().parallelFor(expOrbs.size(), ORB_JOB_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!expOrbs[i]->entity->isActive()) continue;
+            orbTouched[i] = expOrbs[i]->touches(playerColRect);
+        }
+    });
+}
+
+void Game::collectTouchedOrbs() {
+    if (!playerManager) return;
+    for (std::size_t i = 0; i < orbTouched.size(); ++i) {
+        if (orbTouched[i]) expOrbs[i]->collect(*playerManager);
     }
 }
 
 void Game::handleProjectileCollisions(Uint32 currentTime) {
     auto& projectiles = manager.getGroup(Game::groupProjectiles);
     auto& enemies = manager.getGroup(Game::groupEnemies);
-    SDL_Texture* bossProjTexture = Game::instance && Game::instance->assets ? Game::instance->assets->GetTexture("boss_projectile") : nullptr;
+
+    enemyGrid.clear();
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        Entity* e = enemies[i];
+        if (!e || !e->isActive() || !e->hasComponent<ColliderComponent>()) continue;
+        enemyGrid.insert(static_cast<int>(i), e->getComponent<ColliderComponent>().collider);
+    }
 
     for (auto* p : projectiles) {
          if (!p || !p->isActive() || !p->hasComponent<ColliderComponent>() || !p->hasComponent<ProjectileComponent>() || !p->hasComponent<SpriteComponent>() || !p->hasComponent<TransformComponent>()) continue;
@@ -604,16 +903,20 @@ void Game::handleProjectileCollisions(Uint32 currentTime) {
          ProjectileComponent& projComp = p->getComponent<ProjectileComponent>();
          SpriteComponent& projSprite = p->getComponent<SpriteComponent>();
 
-         if (bossProjTexture && projSprite.getTexture() == bossProjTexture) {
+         if (projSprite.getTextureId() == "boss_projectile") {
              continue;
          }
 
-         for (auto* e : enemies) {
+         enemyGrid.query(projectileColliderComp.collider, gridCandidates);
+         for (int idx : gridCandidates) {
+             Entity* e = enemies[idx];
              if (!e || !e->isActive() || !e->hasComponent<ColliderComponent>()) continue;
              if (projComp.hasHit(e)) continue; 
 
              if (Collision::AABB(e->getComponent<ColliderComponent>().collider, projectileColliderComp.collider)) {
                  handleProjectileHitEnemy(p, e, projComp, currentTime);
+                 // Knockback moved the enemy; file it under its new cells too so later projectiles still find it.
+                 if (e->isActive()) enemyGrid.insert(idx, e->getComponent<ColliderComponent>().collider);
                  if (!p->isActive()) break; 
              }
          }
@@ -627,7 +930,7 @@ void Game::handleProjectileCollisions(Uint32 currentTime) {
          ColliderComponent& projCollider = p->getComponent<ColliderComponent>();
          SpriteComponent& projSprite = p->getComponent<SpriteComponent>();
 
-         if (bossProjTexture && projSprite.getTexture() == bossProjTexture) {
+         if (projSprite.getTextureId() == "boss_projectile") {
              if (Collision::AABB(projCollider.collider, playerColRect)) {
                  handleBossProjectileHitPlayer(p, currentTime);
              }
@@ -728,20 +1031,54 @@ void Game::handleEnemySpawning(Uint32 currentTime) {
     }
 }
 
+void Game::advanceReplay() {
+    if (replay.isRecording()) {
+        int viewWidth, viewHeight;
+        getViewportSize(viewWidth, viewHeight);
+        replay.recordTick(getKeyboardState(), mouseX, mouseY, viewWidth, viewHeight);
+    } else if (replay.isPlaying()) {
+        if (replay.nextTick(mouseX, mouseY)) {
+            keyboardOverride = replay.getKeyboardState();
+        } else {
+            keyboardOverride = nullptr;
+            replay.stop();
+        }
+    }
+}
+
+// The viewport bounds projectile culling, so playback uses the recorded size.
+void Game::getViewportSize(int& width, int& height) const {
+    width = WINDOW_WIDTH;
+    height = WINDOW_HEIGHT;
+    if (replay.isPlaying() && replay.getViewWidth() > 0) {
+        width = replay.getViewWidth();
+        height = replay.getViewHeight();
+    } else if (renderer) {
+        SDL_GetRendererOutputSize(renderer, &width, &height);
+    } else if (!headless) {
+        std::cerr << "Warning: Game::renderer is null during camera update!" << std::endl;
+    }
+}
+
 void Game::updateCamera(TransformComponent& playerTransform) {
-    int currentWindowWidth = WINDOW_WIDTH, currentWindowHeight = WINDOW_HEIGHT;
-    if (renderer) { SDL_GetRendererOutputSize(renderer, &currentWindowWidth, &currentWindowHeight); }
-    else { std::cerr << "Warning: Game::renderer is null during camera update!" << std::endl; }
-
-    camera.w = currentWindowWidth;
-    camera.h = currentWindowHeight;
-    camera.x = static_cast<int>(playerTransform.position.x - (currentWindowWidth / 2.0f));
-    camera.y = static_cast<int>(playerTransform.position.y - (currentWindowHeight / 2.0f));
-
-    int mapPixelWidth = MAP_WIDTH * TILE_SIZE;
-    int mapPixelHeight = MAP_HEIGHT * TILE_SIZE;
-    camera.x = std::max(0, std::min(camera.x, mapPixelWidth - camera.w));
-    camera.y = std::max(0, std::min(camera.y, mapPixelHeight - camera.h));
+    camera = cameraFor(playerTransform.position);
+}
+
+SDL_Rect Game::cameraFor(const Vector2D& focus) const {
+    int currentWindowWidth, currentWindowHeight;
+    getViewportSize(currentWindowWidth, currentWindowHeight);
+
+    SDL_Rect view;
+    view.w = currentWindowWidth;
+    view.h = currentWindowHeight;
+    view.x = static_cast<int>(focus.x - (currentWindowWidth / 2.0f));
+    view.y = static_cast<int>(focus.y - (currentWindowHeight / 2.0f));
+
+    int mapPixelWidth = map ? map->getPixelWidth() : MAP_WIDTH * TILE_SIZE;
+    int mapPixelHeight = map ? map->getPixelHeight() : MAP_HEIGHT * TILE_SIZE;
+    view.x = std::max(0, std::min(view.x, mapPixelWidth - view.w));
+    view.y = std::max(0, std::min(view.y, mapPixelHeight - view.h));
+    return view;
 }
 
 void Game::checkPlayerDeath(HealthComponent& playerHealth) {
@@ -839,9 +1176,9 @@ EnemySpawnInfo* Game::selectEnemyBasedOnWeight() {
     }
     if (currentTotalSpawnWeight <= 0) {
         std::cerr << "Warning: Total spawn weight is zero. Picking random enemy." << std::endl;
-        return currentSpawnPool[rand() % currentSpawnPool.size()];
+        return currentSpawnPool[random.nextInt(static_cast<int>(currentSpawnPool.size()))];
     }
-    int randomValue = rand() % currentTotalSpawnWeight;
+    int randomValue = random.nextInt(currentTotalSpawnWeight);
     int cumulativeWeight = 0;
     for (EnemySpawnInfo* enemyInfo : currentSpawnPool) {
         cumulativeWeight += enemyInfo->currentSpawnWeight;
@@ -853,7 +1190,13 @@ EnemySpawnInfo* Game::selectEnemyBasedOnWeight() {
     return currentSpawnPool.back();
 }
 
+void Game::refreshSpawnPoints() {
+    if (map) map->getSpawnPointsNear(camera, MAP_SPAWN_RADIUS_CHUNKS, spawnPoints);
+    else spawnPoints.clear();
+}
+
 void Game::spawnEnemy() {
+    refreshSpawnPoints();
     if (!playerEntity || !playerManager || spawnPoints.empty()) {
         std::cerr << "Cannot spawn enemy, player/spawns incomplete!" << std::endl;
         return;
@@ -865,7 +1208,7 @@ void Game::spawnEnemy() {
         return;
     }
 
-    Vector2D spawnPosition = spawnPoints[std::rand() % spawnPoints.size()];
+    Vector2D spawnPosition = spawnPoints[random.nextInt(static_cast<int>(spawnPoints.size()))];
     auto& enemy = manager.addEntity();
 
     float healthDmgModifier = 1.0f;
@@ -884,13 +1227,12 @@ void Game::spawnEnemy() {
          std::cerr << "ERROR in spawnEnemy: Player missing TransformComponent!" << std::endl;
          enemy.destroy(); return;
     }
-    Vector2D* playerPosPtr = &playerEntity->getComponent<TransformComponent>().position;
-
-    enemy.addComponent<EnemyAIComponent>(5000, selectedEnemyInfo->speed, playerPosPtr, finalDamage, selectedEnemyInfo->baseExperience, playerEntity);
+    enemy.addComponent<EnemyAIComponent>(5000, selectedEnemyInfo->speed, playerEntity->getHandle(), finalDamage, selectedEnemyInfo->baseExperience);
     enemy.addGroup(groupEnemies);
 }
 
 void Game::spawnBoss() { 
+    refreshSpawnPoints();
     if (spawnPoints.empty() || !playerEntity || !playerManager || !playerEntity->hasComponent<TransformComponent>()) {
         std::cerr << "Cannot spawn boss: No spawn points or player not ready!" << std::endl;
         return;
@@ -901,7 +1243,7 @@ void Game::spawnBoss() {
              return;
         }
     }
-    Vector2D spawnPosition = spawnPoints[std::rand() % spawnPoints.size()];
+    Vector2D spawnPosition = spawnPoints[random.nextInt(static_cast<int>(spawnPoints.size()))];
     spawnBossAt(spawnPosition);
 }
 
@@ -1028,7 +1370,7 @@ void Game::generateBuffOptions() {
         std::vector<int> chosenIndices;
 
         while (chosenIndices.size() < static_cast<size_t>(randomSlotsToFill)) {
-            int randIndex = std::rand() % numPossibleRandom;
+            int randIndex = random.nextInt(numPossibleRandom);
             bool alreadyChosen = false;
             for (int chosen : chosenIndices) { if (chosen == randIndex) { alreadyChosen = true; break; } }
 
@@ -1051,6 +1393,7 @@ void Game::generateBuffOptions() {
 }
 
 void Game::applySelectedBuff(int index) {
+    if (isInBuffSelection) replay.recordBuffChoice(index);
     if (!isInBuffSelection || !playerEntity || !playerManager || index < 0 || index >= (int)currentBuffOptions.size()) { if (isInBuffSelection) exitBuffSelection(); return; }
     const BuffInfo& selectedBuff = currentBuffOptions[index];
     int intAmount = static_cast<int>(selectedBuff.amount); float floatAmount = selectedBuff.amount;
@@ -1073,7 +1416,7 @@ void Game::applySelectedBuff(int index) {
         case BuffType::PLAYER_LIFESTEAL: playerManager->setLifestealPercentage(playerManager->getLifestealPercentage() + floatAmount); buffApplied = true; break;
 
         case BuffType::WEAPON_DAMAGE_FLAT: if (weaponComp) { int increase = std::max(1, static_cast<int>(weaponComp->getDamage() * 0.20f)); weaponComp->increaseDamage(increase); weaponComp->incrementLevel(); buffApplied = true; } break;
-        case BuffType::WEAPON_DAMAGE_RAND_PERC: if (weaponComp) { int increase = std::max(1, static_cast<int>(weaponComp->getDamage() * ((rand() % 50 + 1) / 100.0f))); weaponComp->increaseDamage(increase); weaponComp->incrementLevel(); buffApplied = true; } break;
+        case BuffType::WEAPON_DAMAGE_RAND_PERC: if (weaponComp) { int increase = std::max(1, static_cast<int>(weaponComp->getDamage() * ((random.nextInt(50) + 1) / 100.0f))); weaponComp->increaseDamage(increase); weaponComp->incrementLevel(); buffApplied = true; } break;
         case BuffType::WEAPON_FIRE_RATE: if (weaponComp) { weaponComp->decreaseFireRatePercentage(floatAmount); weaponComp->incrementLevel(); buffApplied = true; } break;
         case BuffType::WEAPON_PIERCE: if (weaponComp) { weaponComp->increasePierce(intAmount); weaponComp->incrementLevel(); buffApplied = true; } break;
         case BuffType::WEAPON_BURST_COUNT: if(weaponComp) { weaponComp->increaseBurstCount(intAmount); weaponComp->incrementLevel(); buffApplied = true; } break;
@@ -8,9 +8,18 @@
 #include <string>
 #include <map> 
 #include "Vector2D.h"
+#include "constants.h"
 #include "ECS/ECS.h"
 #include "UI.h"
 #include "SaveLoadManager.h"
+#include "SpatialHash.h"
+#include "UniformGrid.h"
+#include "Random.h"
+#include "Replay.h"
+#include "SpriteBatch.h"
+#include "FlowField.h"
+#include "CrowdSteering.h"
+#include "JobSystem.h"
 
 class AssetManager;
 class Entity;
@@ -18,6 +27,8 @@ class Map;
 class ColliderComponent;
 class TransformComponent;   
 class ProjectileComponent; 
+class EnemyAIComponent;
+class ExpOrbComponent;
 class HealthComponent;     
 class UIManager;
 class Player;
@@ -86,11 +97,22 @@ public:
     static SDL_Renderer* renderer;
     static SDL_Event event;
     static SDL_Rect camera;
+    static float renderAlpha;
     static bool isRunning;
     static int mouseX;
     static int mouseY;
     static int musicVolume; 
     static int sfxVolume;   
+    static bool headless;
+    static bool audioEnabled;
+    static const Uint8* keyboardOverride;
+    static Random random;
+    static std::string replayRecordPath;
+    static std::string replayPlaybackPath;
+
+    // Simulation time in milliseconds. Advances only while the game is being updated.
+    static Uint32 getTicks();
+    static const Uint8* getKeyboardState();
 
     enum groupLabels : std::size_t {
         groupMap, groupPlayers, groupColliders, groupProjectiles, groupEnemies, groupExpOrbs
@@ -98,9 +120,12 @@ public:
 
     Manager manager;
     AssetManager* assets = nullptr;
+    // Open only while Game::render draws the world; sprites fall back to direct draws otherwise.
+    SpriteBatch spriteBatch;
     Player* playerManager = nullptr;
     Entity* playerEntity = nullptr;
     SaveLoadManager* saveLoadManager = nullptr;
+    // Spawn points near the camera, refreshed from the map before each spawn.
     std::vector<Vector2D> spawnPoints;
     std::string currentPlayerName = "Player";
     GameState currentState = GameState::Playing;
@@ -137,6 +162,10 @@ public:
 
     Entity& getPlayer();
     Player* getPlayerManager() { return playerManager; }
+    Map* getMap() { return map; }
+    const FlowField& getFlowField() const { return flowField; }
+    bool isChoosingBuff() const { return isInBuffSelection; }
+    Replay& getReplay() { return replay; }
     std::string getPlayerName() const { return currentPlayerName; }
 
     void setPlayerName(const std::string& name) {
@@ -147,8 +176,13 @@ public:
 
 private:
 
+    static Uint64 simulationTicks;
+
     UIManager* ui = nullptr;
     Map* map = nullptr;
+    Replay replay;
+    bool showPerfOverlay = false;
+    std::vector<std::pair<const char*, std::size_t>> perfGroupCounts;
 
     Uint32 lastEnemySpawnTime = 0;
     Uint32 lastShotTime = 0; 
@@ -189,13 +223,54 @@ private:
     std::vector<EnemySpawnInfo*> currentSpawnPool;
     int currentTotalSpawnWeight = 0;
 
+    SpatialHash enemyGrid;
+    std::vector<int> gridCandidates;
+    FlowField flowField{FLOW_FIELD_TILES_PER_UPDATE};
+    CrowdSteering crowdSteering;
+    // Per-tick graph of the parallel passes; their results, one slot per
+    // group member, are applied on the main thread once it has run.
+    TaskGraph simulationGraph;
+    std::vector<Entity*> crowdMembers;
+    std::vector<EnemyAIComponent*> enemyBrains;
+    std::vector<ProjectileComponent*> projectileMovers;
+    std::vector<ExpOrbComponent*> expOrbs;
+    std::uint32_t enemyListVersion = 0;
+    std::uint32_t projectileListVersion = 0;
+    std::uint32_t orbListVersion = 0;
+    bool simulationListsStale = true;
+    std::vector<int> enemyContactDamage;
+    std::vector<char> projectileExpired;
+    std::vector<char> orbTouched;
+
+    // Rebuilt every frame from the interpolated sprite bounds; ids index drawables in draw order.
+    UniformGrid visibilityGrid{VISIBILITY_GRID_CELL_SIZE};
+    std::vector<Entity*> drawables;
+    std::vector<SDL_Rect> drawableBounds;
+    std::vector<int> visibleDrawables;
+    std::size_t firstEnemyDrawable = 0;
+    void collectVisibleEntities();
+
     void handleTerrainCollision(ColliderComponent& playerCollider, TransformComponent& playerTransform, SDL_Rect& playerColRect);
     void handleProjectileCollisions(Uint32 currentTime);
     void handleProjectileHitEnemy(Entity* projectile, Entity* enemy, ProjectileComponent& projComp, Uint32 currentTime);
     void handleEnemyDeath(Entity* enemy, int maxHp);
     void handleBossProjectileHitPlayer(Entity* projectile, Uint32 currentTime);
     void handleEnemySpawning(Uint32 currentTime);
+    void refreshSpawnPoints();
+    void updateFlowField();
+    void buildSimulationGraph();
+    void gatherSimulationLists();
+    void thinkEnemies(Uint32 currentTime);
+    void applyEnemyContactDamage(Uint32 currentTime);
+    void moveProjectiles();
+    void destroyExpiredProjectiles();
+    void findTouchedOrbs();
+    void collectTouchedOrbs();
     void updateCamera(TransformComponent& playerTransform);
+    SDL_Rect cameraFor(const Vector2D& focus) const;
+    void getViewportSize(int& width, int& height) const;
+    void advanceReplay();
+    void renderPerfOverlay();
     void checkPlayerDeath(HealthComponent& playerHealth);
     void spawnBossAt(Vector2D spawnPos); 
 
@@ -3,14 +3,27 @@
 #include <SDL_ttf.h>
 #include <SDL_mixer.h>
 #include <iostream>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifdef _WIN32
 #include <Windows.h> 
+#endif
 #include "constants.h"
 #include "game.h"
+#include "MapFile.h"
+#include "Profiler.h"
+#include "TextTextureCache.h"
+#include "ECS/Components.h"
 #include "Scene/SceneComponent.h" 
 
 static SDL_Window* mainWindow = nullptr; 
 
 void setupConsole() {
+#ifdef _WIN32
     if (AttachConsole(ATTACH_PARENT_PROCESS) || AllocConsole()) {
         FILE* pCout, * pCerr, * pCin;
         freopen_s(&pCout, "CONOUT$", "w", stdout);
@@ -20,6 +33,7 @@ void setupConsole() {
     } else {
         std::cerr << "Failed to setup console." << std::endl;
     }
+#endif
 }
 
 void toggleFullscreen() {
@@ -43,11 +57,135 @@ void toggleFullscreen() {
 
 }
 
+// Walks the player in a slow square and sweeps the aim around it so weapons,
+// spells, pickups and spawning all get exercised without a human at the keys.
+static void driveSyntheticInput(Game& game, std::array<Uint8, SDL_NUM_SCANCODES>& keys, Uint64 tick) {
+    static const SDL_Scancode walkPattern[] = {SDL_SCANCODE_D, SDL_SCANCODE_S, SDL_SCANCODE_A, SDL_SCANCODE_W};
+    keys.fill(0);
+    keys[walkPattern[(tick / (FPS * 3)) % 4]] = 1;
+
+    if (!game.playerEntity || !game.playerEntity->hasComponent<TransformComponent>()) return;
+    const Vector2D& playerPos = game.playerEntity->getComponent<TransformComponent>().position;
+    float aimAngle = static_cast<float>(tick % (FPS * 2)) / (FPS * 2) * 6.2831853f;
+    Game::mouseX = static_cast<int>(playerPos.x + std::cos(aimAngle) * 200.0f);
+    Game::mouseY = static_cast<int>(playerPos.y + std::sin(aimAngle) * 200.0f);
+}
+
+static int runHeadless(Uint64 maxTicks, bool invulnerable, const std::string& tracePath) {
+    if (SDL_Init(SDL_INIT_TIMER) < 0) {
+        std::cerr << "SDL could not initialize! SDL Error: " << SDL_GetError() << std::endl;
+        return -1;
+    }
+
+    Game::headless = true;
+    Game::audioEnabled = false;
+    std::array<Uint8, SDL_NUM_SCANCODES> keys{};
+    Game::keyboardOverride = keys.data();
+
+    int result = 0;
+    {
+        Game game;
+        game.init();
+        if (!Game::isRunning || !game.playerEntity) {
+            std::cerr << "Headless: Game failed to initialize." << std::endl;
+            result = -1;
+        } else {
+            const double counterFrequency = static_cast<double>(SDL_GetPerformanceFrequency());
+            const Uint64 startCounter = SDL_GetPerformanceCounter();
+            Uint64 intervalCounter = startCounter;
+            Uint64 tick = 0;
+
+            const bool replaying = game.getReplay().isPlaying();
+            for (; tick < maxTicks; ++tick) {
+                if (replaying) {
+                    if (!game.getReplay().isPlaying()) break;
+                } else {
+                    driveSyntheticInput(game, keys, tick);
+                    if (game.isChoosingBuff()) {
+                        game.applySelectedBuff(0);
+                    }
+                }
+                if (invulnerable && game.playerEntity->hasComponent<HealthComponent>()) {
+                    HealthComponent& health = game.playerEntity->getComponent<HealthComponent>();
+                    health.setHealth(health.getMaxHealth());
+                }
+                if (game.currentState == GameState::GameOver) {
+                    std::cout << "Headless: Player died at tick " << tick << "." << std::endl;
+                    break;
+                }
+
+                {
+                    PROFILE_SCOPE("Tick");
+                    game.update();
+                }
+
+                if ((tick + 1) % (FPS * 60) == 0) {
+                    Uint64 now = SDL_GetPerformanceCounter();
+                    double intervalMs = (now - intervalCounter) * 1000.0 / counterFrequency;
+                    intervalCounter = now;
+                    std::cout << "Headless: tick " << (tick + 1)
+                              << " enemies=" << game.manager.getGroup(Game::groupEnemies).size()
+                              << " projectiles=" << game.manager.getGroup(Game::groupProjectiles).size()
+                              << " orbs=" << game.manager.getGroup(Game::groupExpOrbs).size()
+                              << " avg_tick_ms=" << intervalMs / (FPS * 60) << std::endl;
+                }
+            }
+
+            double totalSeconds = (SDL_GetPerformanceCounter() - startCounter) / counterFrequency;
+            if (!tracePath.empty()) {
+                Profiler::writeChromeTrace(tracePath);
+            }
+            std::cout << "Headless: " << tick << " ticks in " << totalSeconds << " s ("
+                      << (totalSeconds > 0.0 ? tick / totalSeconds : 0.0) << " ticks/s)" << std::endl;
+        }
+    }
+
+    Game::keyboardOverride = nullptr;
+    SDL_Quit();
+    return result;
+}
+
 int main(int argc, char* argv[]) {
-    (void)argc; 
-    (void)argv; 
+    bool headless = false;
+    bool invulnerable = false;
+    Uint64 headlessTicks = HEADLESS_DEFAULT_TICKS;
+    std::string tracePath;
+    std::string compileMapPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strncmp(argv[i], "--ticks=", 8) == 0) {
+            headlessTicks = std::strtoull(argv[i] + 8, nullptr, 10);
+        } else if (std::strcmp(argv[i], "--invulnerable") == 0) {
+            invulnerable = true;
+        } else if (std::strncmp(argv[i], "--trace=", 8) == 0) {
+            tracePath = argv[i] + 8;
+        } else if (std::strncmp(argv[i], "--record=", 9) == 0) {
+            Game::replayRecordPath = argv[i] + 9;
+        } else if (std::strncmp(argv[i], "--replay=", 9) == 0) {
+            Game::replayPlaybackPath = argv[i] + 9;
+        } else if (std::strncmp(argv[i], "--compile-map=", 14) == 0) {
+            compileMapPath = argv[i] + 14;
+        }
+    }
+
+    if (!compileMapPath.empty()) {
+        std::vector<std::uint8_t> image;
+        std::string outPath = MapFile::compiledPathFor(compileMapPath);
+        if (outPath == compileMapPath || !MapFile::compileCsv(compileMapPath, MAP_CHUNK_TILES, image) || !MapFile::writeFile(outPath, image)) {
+            std::cerr << "Failed to compile map '" << compileMapPath << "'." << std::endl;
+            return 1;
+        }
+        std::cout << "Compiled " << compileMapPath << " -> " << outPath << " (" << image.size() << " bytes)." << std::endl;
+        return 0;
+    }
 
     setupConsole();
+    Profiler::setThreadName("Main");
+
+    if (headless) {
+        return runHeadless(headlessTicks, invulnerable, tracePath);
+    }
 
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_TIMER) < 0) { 
         std::cerr << "SDL could not initialize! SDL Error: " << SDL_GetError() << std::endl;
@@ -69,6 +207,7 @@ int main(int argc, char* argv[]) {
 
     if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) { 
         std::cerr << "SDL_mixer could not initialize! SDL_mixer Error: " << Mix_GetError() << std::endl;
+        Game::audioEnabled = false;
     } else {
         Mix_AllocateChannels(16); 
 
@@ -106,15 +245,25 @@ int main(int argc, char* argv[]) {
     sceneManager.addScene(SceneType::Game, std::make_unique<GameScene>());
     sceneManager.switchToScene(SceneType::Menu); 
 
-    const int frameDelay = 1000 / FPS;
-    Uint32 frameStart;
-    int frameTime;
+    SDL_RendererInfo rendererInfo;
+    bool vsyncEnabled = SDL_GetRendererInfo(renderer, &rendererInfo) == 0 && (rendererInfo.flags & SDL_RENDERER_PRESENTVSYNC);
+
+    const double counterFrequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    Uint64 previousCounter = SDL_GetPerformanceCounter();
+    double accumulator = 0.0;
     bool gameIsRunning = true; 
     SDL_Event event;
 
     while (gameIsRunning) {
-        frameStart = SDL_GetTicks();
-
+        PROFILE_SCOPE("Frame");
+        Uint64 currentCounter = SDL_GetPerformanceCounter();
+        double frameTime = (currentCounter - previousCounter) / counterFrequency;
+        previousCounter = currentCounter;
+        // Cap the catch-up after a stall (window drag, breakpoint) instead of fast-forwarding.
+        if (frameTime > MAX_FRAME_TIME) frameTime = MAX_FRAME_TIME;
+        accumulator += frameTime;
+
+        Uint64 eventsStart = Profiler::now();
         while (SDL_PollEvent(&event)) {
             if (event.type == SDL_QUIT) {
                 gameIsRunning = false;
@@ -124,6 +273,10 @@ int main(int argc, char* argv[]) {
                 toggleFullscreen();
             }
 
+            if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F9) {
+                Profiler::writeChromeTrace(PROFILER_TRACE_PATH);
+            }
+
             if(Game::instance) { 
                 Game::event = event;
             }
@@ -131,19 +284,26 @@ int main(int argc, char* argv[]) {
             sceneManager.handleEvents(event);
         }
 
-        sceneManager.update();
+        if (Profiler::isEnabled()) Profiler::record("Events", eventsStart, Profiler::now());
+
+        while (accumulator >= FIXED_TIMESTEP) {
+            PROFILE_SCOPE("Tick");
+            sceneManager.update();
+            accumulator -= FIXED_TIMESTEP;
+        }
 
+        Game::renderAlpha = static_cast<float>(accumulator / FIXED_TIMESTEP);
         sceneManager.render(); 
 
-        frameTime = SDL_GetTicks() - frameStart;
-        if (frameDelay > frameTime) {
-            SDL_Delay(frameDelay - frameTime);
+        if (!vsyncEnabled) {
+            SDL_Delay(1);
         }
     }
 
     std::cout << "Cleaning up application resources..." << std::endl;
 
     sceneManager.clean(); 
+    TextTextureCache::shared().clear();
 
     if(Game::renderer) { 
        SDL_DestroyRenderer(Game::renderer);
@@ -3,9 +3,10 @@
 #include "constants.h"
 #include "ECS/ECS.h"
 #include "ECS/Components.h"
-#include <fstream>
+#include "AssetManager.h"
+#include "Profiler.h"
+#include <algorithm>
 #include <iostream>
-#include <sstream>
 #include <vector>
 #include <string>
 
@@ -15,86 +16,371 @@ Map::Map(Manager& manager, std::string tID, int mscale, int tsize)
     scaledSize = tsize * mscale;
 }
 
-Map::~Map() { }
+Map::~Map() {
+    unload();
+}
+
+bool Map::LoadMap(std::string path, int griWidth) { 
+    unload();
+    gridWidth = griWidth > 0 ? griWidth : 1;
+
+    std::string compiledPath = MapFile::compiledPathFor(path);
+    bool canCompile = compiledPath != path;
+    bool mapped = !(canCompile && MapFile::isStale(compiledPath, path)) &&
+                  mappedFile.open(compiledPath) && MapFile::parse(mappedFile.data(), mappedFile.size(), view);
 
-void Map::LoadMap(std::string path, int sizeX, int sizeY, int griWidth, std::vector<Vector2D>& outSpawnPoints) { 
-    std::ifstream mapFile(path);
-    if (!mapFile.is_open()) {
-         std::cerr << "Error: Could not open map file: " << path << std::endl;
-         return;
+    if (!mapped && canCompile) {
+        // Missing, older than the CSV, or from an older format version.
+        mappedFile.close();
+        std::vector<std::uint8_t> image;
+        if (!MapFile::compileCsv(path, MAP_CHUNK_TILES, image)) return false;
+        if (MapFile::writeFile(compiledPath, image) && mappedFile.open(compiledPath)) {
+            std::cout << "Map compiled to " << compiledPath << "." << std::endl;
+            mapped = MapFile::parse(mappedFile.data(), mappedFile.size(), view);
+        } else {
+            // Still playable from memory; it just gets rebuilt next launch.
+            memoryImage.swap(image);
+            mapped = MapFile::parse(memoryImage.data(), memoryImage.size(), view);
+        }
+    }
+    if (!mapped) {
+        std::cerr << "Error: Could not load map file: " << compiledPath << std::endl;
+        unload();
+        return false;
     }
-    std::string line;
-    std::vector<std::vector<int>> mapData;
 
-    outSpawnPoints.clear();
+    widthInTiles = static_cast<int>(view.width);
+    heightInTiles = static_cast<int>(view.height);
+    std::cout << "Map: " << compiledPath << " is " << widthInTiles << "x" << heightInTiles << " tiles." << std::endl;
+
+    std::size_t chunkCount = static_cast<std::size_t>(view.chunksX) * view.chunksY;
+    chunkSlots.resize(chunkCount);
+    chunkRequested.assign(chunkCount, 0);
+    loaded = true;
+    startStreaming();
+
+    std::cout << "Map loaded. Found " << view.spawnCount << " spawn points in " << chunkCount << " chunks." << std::endl; 
+    return true;
+}
+
+void Map::unload() {
+    stopStreaming();
+    for (int index : residentChunks) {
+        if (chunkSlots[index] && chunkSlots[index]->texture) SDL_DestroyTexture(chunkSlots[index]->texture);
+    }
+    residentChunks.clear();
+    chunkSlots.clear();
+    chunkRequested.clear();
+    mappedFile.close();
+    memoryImage.clear();
+    view = MapFile::View();
+    widthInTiles = heightInTiles = 0;
+    loaded = false;
+}
+
+void Map::startStreaming() {
+    streamStopping = false;
+    streamThread = std::thread(&Map::streamWorker, this);
+}
+
+void Map::stopStreaming() {
+    if (!streamThread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(streamMutex);
+        streamStopping = true;
+        streamRequests.clear();
+    }
+    streamWake.notify_all();
+    streamThread.join();
+    streamResults.clear();
+}
+
+void Map::streamWorker() {
+    Profiler::setThreadName("Map streaming");
+    std::unique_lock<std::mutex> lock(streamMutex);
+    while (true) {
+        streamWake.wait(lock, [this] { return streamStopping || !streamRequests.empty(); });
+        if (streamStopping) return;
+        int index = streamRequests.front();
+        streamRequests.pop_front();
+
+        // The mapping and view never change while the worker runs, so decoding needs no lock.
+        lock.unlock();
+        std::unique_ptr<MapChunk> chunk;
+        {
+            PROFILE_SCOPE("Map::decodeChunk");
+            chunk = decodeChunk(index);
+        }
+        lock.lock();
+        streamResults.push_back(std::move(chunk));
+    }
+}
+
+std::unique_ptr<Map::MapChunk> Map::decodeChunk(int index) const {
+    std::unique_ptr<MapChunk> chunk(new MapChunk());
+    const int chunkTiles = view.chunkTiles;
+    chunk->index = index;
+    chunk->firstTileX = (index % view.chunksX) * chunkTiles;
+    chunk->firstTileY = (index / view.chunksX) * chunkTiles;
+    chunk->tilesW = std::min(chunkTiles, widthInTiles - chunk->firstTileX);
+    chunk->tilesH = std::min(chunkTiles, heightInTiles - chunk->firstTileY);
+    chunk->worldRect = {chunk->firstTileX * scaledSize, chunk->firstTileY * scaledSize,
+                        chunk->tilesW * scaledSize, chunk->tilesH * scaledSize};
 
-    while (std::getline(mapFile, line)) {
-        if (line.empty() || line[0] == '#') continue;
-        std::istringstream ss(line);
-        std::vector<int> row;
-        std::string value;
-        int tileCode;
-        while (std::getline(ss, value, ',')) {
-             try {
-                 tileCode = std::stoi(value);
-                 row.push_back(tileCode);
-             } catch (const std::exception& e) { 
-                 std::cerr << "Map Load Error: Invalid value '" << value << "' (" << e.what() << "). Skipping row." << std::endl;
-                 row.clear();
-                 break;
-             }
+    std::size_t localCells = static_cast<std::size_t>(chunk->tilesW) * chunk->tilesH;
+    chunk->tileCodes.resize(localCells);
+    chunk->solidBits.assign((localCells + 63) / 64, 0);
+    std::size_t local = 0;
+    for (int ty = chunk->firstTileY; ty < chunk->firstTileY + chunk->tilesH; ++ty) {
+        std::size_t cell = static_cast<std::size_t>(ty) * widthInTiles + chunk->firstTileX;
+        for (int i = 0; i < chunk->tilesW; ++i, ++cell, ++local) {
+            std::uint16_t code = view.tileAt(cell);
+            chunk->tileCodes[local] = code == MapFile::emptyTile ? -1 : code;
+            if ((view.solidWord(cell >> 6) >> (cell & 63)) & 1u) {
+                chunk->solidBits[local >> 6] |= std::uint64_t{1} << (local & 63);
+            }
         }
-        if (!row.empty()) {
-            mapData.push_back(row);
+    }
+
+    std::size_t first = 0, count = 0;
+    view.chunkSpawns(index, first, count);
+    chunk->spawnPoints.reserve(count);
+    for (std::size_t i = first; i < first + count; ++i) {
+        int x = 0, y = 0;
+        view.spawnAt(i, x, y);
+        chunk->spawnPoints.emplace_back(static_cast<float>(x * scaledSize), static_cast<float>(y * scaledSize));
+    }
+    return chunk;
+}
+
+void Map::getChunkRange(const SDL_Rect& area, int radiusChunks, int& minX, int& minY, int& maxX, int& maxY) const {
+    int chunkPixels = view.chunkTiles * scaledSize;
+    auto floorDiv = [](int a, int b) { return a >= 0 ? a / b : -((-a + b - 1) / b); };
+    minX = std::max(0, floorDiv(area.x, chunkPixels) - radiusChunks);
+    minY = std::max(0, floorDiv(area.y, chunkPixels) - radiusChunks);
+    maxX = std::min(view.chunksX - 1, floorDiv(area.x + area.w - 1, chunkPixels) + radiusChunks);
+    maxY = std::min(view.chunksY - 1, floorDiv(area.y + area.h - 1, chunkPixels) + radiusChunks);
+}
+
+void Map::updateStreaming(const SDL_Rect& area) {
+    if (!loaded) return;
+    PROFILE_SCOPE("Map::updateStreaming");
+
+    int keepMinX, keepMinY, keepMaxX, keepMaxY;
+    getChunkRange(area, MAP_STREAM_KEEP_CHUNKS, keepMinX, keepMinY, keepMaxX, keepMaxY);
+    auto inKeepRange = [&](int index) {
+        int cx = index % view.chunksX, cy = index / view.chunksX;
+        return cx >= keepMinX && cx <= keepMaxX && cy >= keepMinY && cy <= keepMaxY;
+    };
+
+    std::vector<std::unique_ptr<MapChunk>> arrived;
+    {
+        std::lock_guard<std::mutex> lock(streamMutex);
+        arrived.swap(streamResults);
+        // Requests the player has already moved away from are not worth decoding.
+        for (auto it = streamRequests.begin(); it != streamRequests.end();) {
+            if (inKeepRange(*it)) { ++it; continue; }
+            chunkRequested[*it] = 0;
+            it = streamRequests.erase(it);
+        }
+    }
+    for (auto& chunk : arrived) {
+        int index = chunk->index;
+        chunkRequested[index] = 0;
+        if (!chunkSlots[index] && inKeepRange(index)) installChunk(std::move(chunk));
+    }
+
+    for (std::size_t i = 0; i < residentChunks.size();) {
+        if (inKeepRange(residentChunks[i])) { ++i; continue; }
+        evictChunk(residentChunks[i]);
+    }
+
+    // Chunks on screen can't wait for the worker.
+    int minX, minY, maxX, maxY;
+    getChunkRange(area, 0, minX, minY, maxX, maxY);
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            int index = cy * view.chunksX + cx;
+            if (!chunkSlots[index]) installChunk(decodeChunk(index));
         }
     }
 
-    for (int y = 0; y < sizeY && y < static_cast<int>(mapData.size()); ++y) {
-        for (int x = 0; x < sizeX && x < static_cast<int>(mapData[y].size()); ++x) {
-            int tileCode = mapData[y][x];
+    getChunkRange(area, MAP_STREAM_PREFETCH_CHUNKS, minX, minY, maxX, maxY);
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(streamMutex);
+        for (int cy = minY; cy <= maxY; ++cy) {
+            for (int cx = minX; cx <= maxX; ++cx) {
+                int index = cy * view.chunksX + cx;
+                if (chunkSlots[index] || chunkRequested[index]) continue;
+                chunkRequested[index] = 1;
+                streamRequests.push_back(index);
+                queued = true;
+            }
+        }
+    }
+    if (queued) streamWake.notify_one();
+}
+
+void Map::installChunk(std::unique_ptr<MapChunk> chunk) {
+    int index = chunk->index;
+    bakeChunk(*chunk);
+    chunkSlots[index] = std::move(chunk);
+    residentChunks.push_back(index);
+}
+
+void Map::evictChunk(int index) {
+    if (chunkSlots[index] && chunkSlots[index]->texture) SDL_DestroyTexture(chunkSlots[index]->texture);
+    chunkSlots[index].reset();
+    residentChunks.erase(std::find(residentChunks.begin(), residentChunks.end(), index));
+}
+
+const Map::MapChunk* Map::residentChunkAt(int tileX, int tileY) const {
+    int index = (tileY / view.chunkTiles) * view.chunksX + tileX / view.chunkTiles;
+    return chunkSlots[index].get();
+}
+
+SDL_Rect Map::getTileSrcRect(int tileCode) const {
+    return {(tileCode % gridWidth) * tileSize, (tileCode / gridWidth) * tileSize, tileSize, tileSize};
+}
+
+void Map::drawChunkTiles(SDL_Texture* tileset, const MapChunk& chunk, int offsetX, int offsetY) {
+    std::size_t local = 0;
+    for (int ty = chunk.firstTileY; ty < chunk.firstTileY + chunk.tilesH; ++ty) {
+        for (int tx = chunk.firstTileX; tx < chunk.firstTileX + chunk.tilesW; ++tx, ++local) {
+            int tileCode = chunk.tileCodes[local];
             if (tileCode < 0) continue;
+            SDL_Rect src = getTileSrcRect(tileCode);
+            SDL_Rect dest = {tx * scaledSize - offsetX, ty * scaledSize - offsetY, scaledSize, scaledSize};
+            TextureManager::RenderCopy(Game::renderer, tileset, &src, &dest);
+        }
+    }
+}
+
+void Map::bakeChunks() {
+    for (int index : residentChunks) bakeChunk(*chunkSlots[index]);
+}
+
+void Map::bakeChunk(MapChunk& chunk) {
+    if (chunk.texture) {
+        SDL_DestroyTexture(chunk.texture);
+        chunk.texture = nullptr;
+    }
+
+    SDL_Texture* tileset = Game::instance && Game::instance->assets ? Game::instance->assets->GetTexture(texID).texture : nullptr;
+    if (!Game::renderer || !tileset) return;
+    // Without render targets the chunk is drawn tile by tile from its tile codes.
+    if (!SDL_RenderTargetSupported(Game::renderer)) return;
 
-            int srcX = tileCode % griWidth;
-            int srcY = tileCode / griWidth;
-            AddTile(srcX * tileSize, srcY * tileSize, x * scaledSize, y * scaledSize);
+    chunk.texture = SDL_CreateTexture(Game::renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, chunk.worldRect.w, chunk.worldRect.h);
+    if (!chunk.texture) {
+        std::cerr << "Warning: Failed to create map chunk texture: " << SDL_GetError() << std::endl;
+        return;
+    }
 
-             if (tileCode == 10|| tileCode == 11 || tileCode == 12 || tileCode == 13) {
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(Game::renderer);
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(Game::renderer, &r, &g, &b, &a);
 
-                 outSpawnPoints.emplace_back(static_cast<float>(x * scaledSize), static_cast<float>(y * scaledSize));
-             }
+    SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderTarget(Game::renderer, chunk.texture);
+    SDL_SetRenderDrawColor(Game::renderer, 0, 0, 0, 0);
+    SDL_RenderClear(Game::renderer);
+    drawChunkTiles(tileset, chunk, chunk.worldRect.x, chunk.worldRect.y);
+
+    SDL_SetRenderTarget(Game::renderer, previousTarget);
+    SDL_SetRenderDrawColor(Game::renderer, r, g, b, a);
+}
+
+void Map::draw() {
+    if (!Game::renderer || !loaded) return;
+
+    SDL_Texture* tileset = nullptr;
+    for (int index : residentChunks) {
+        const MapChunk& chunk = *chunkSlots[index];
+        if (!SDL_HasIntersection(&chunk.worldRect, &Game::camera)) continue;
+
+        if (chunk.texture) {
+            SDL_Rect dest = {chunk.worldRect.x - Game::camera.x, chunk.worldRect.y - Game::camera.y, chunk.worldRect.w, chunk.worldRect.h};
+            TextureManager::RenderCopy(Game::renderer, chunk.texture, NULL, &dest);
+        } else {
+            if (!tileset && Game::instance && Game::instance->assets) tileset = Game::instance->assets->GetTexture(texID).texture;
+            if (tileset) drawChunkTiles(tileset, chunk, Game::camera.x, Game::camera.y);
         }
     }
+}
+
+void Map::getSpawnPointsNear(const SDL_Rect& area, int radiusChunks, std::vector<Vector2D>& outSpawnPoints) const {
+    outSpawnPoints.clear();
+    if (!loaded) return;
 
-     std::cout << "Map loaded. Found " << outSpawnPoints.size() << " spawn points." << std::endl; 
-
-    mapFile.clear();
-    mapFile.seekg(0);
-    int currentY = 0;
-    while (std::getline(mapFile, line)) {
-        if (line.empty() || line[0] == '#') continue;
-        if (currentY >= sizeY) break;
-        std::istringstream ss(line);
-        std::string value;
-        int currentX = 0;
-        while (std::getline(ss, value, ',')) {
-            if (currentX >= sizeX) break;
-            if (!mapData.empty() && currentY < static_cast<int>(mapData.size()) && currentX < static_cast<int>(mapData[currentY].size())) {
-                if (mapData[currentY][currentX] == 6 || mapData[currentY][currentX] == 2 || mapData[currentY][currentX] == 4 || mapData[currentY][currentX] == 1 ||mapData[currentY][currentX] == 8 || mapData[currentY][currentX] == 3 || mapData[currentY][currentX] == 5) { 
-                    auto& tcol(manager_ref.addEntity());
-                    tcol.addComponent<ColliderComponent>("terrain", currentX * scaledSize, currentY * scaledSize, scaledSize);
-                    tcol.addGroup(Game::groupColliders);
-                }
+    int minX, minY, maxX, maxY;
+    getChunkRange(area, radiusChunks, minX, minY, maxX, maxY);
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            int index = cy * view.chunksX + cx;
+            if (const MapChunk* chunk = chunkSlots[index].get()) {
+                outSpawnPoints.insert(outSpawnPoints.end(), chunk->spawnPoints.begin(), chunk->spawnPoints.end());
+                continue;
+            }
+            std::size_t first = 0, count = 0;
+            view.chunkSpawns(index, first, count);
+            for (std::size_t i = first; i < first + count; ++i) {
+                int x = 0, y = 0;
+                view.spawnAt(i, x, y);
+                outSpawnPoints.emplace_back(static_cast<float>(x * scaledSize), static_cast<float>(y * scaledSize));
             }
-            currentX++;
         }
-        currentY++;
     }
 
-    mapFile.close();
+    // Chunk order would otherwise leak into which spawn a random index picks.
+    std::sort(outSpawnPoints.begin(), outSpawnPoints.end(), [](const Vector2D& a, const Vector2D& b) {
+        return a.y != b.y ? a.y < b.y : a.x < b.x;
+    });
+}
+
+bool Map::isSolidTileCode(int tileCode) {
+    switch (tileCode) {
+        case 1: case 2: case 3: case 4: case 5: case 6: case 8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool Map::isSpawnTileCode(int tileCode) {
+    return tileCode >= 10 && tileCode <= 13;
+}
+
+bool Map::isSolid(int tileX, int tileY) const {
+    if (!loaded || tileX < 0 || tileY < 0 || tileX >= widthInTiles || tileY >= heightInTiles) return false;
+    if (const MapChunk* chunk = residentChunkAt(tileX, tileY)) {
+        std::size_t local = static_cast<std::size_t>(tileY - chunk->firstTileY) * chunk->tilesW + (tileX - chunk->firstTileX);
+        return (chunk->solidBits[local >> 6] >> (local & 63)) & 1u;
+    }
+    std::size_t bit = static_cast<std::size_t>(tileY) * widthInTiles + tileX;
+    return (view.solidWord(bit >> 6) >> (bit & 63)) & 1u;
+}
+void Map::getTileRange(const SDL_Rect& rect, int& minX, int& minY, int& maxX, int& maxY) const {
+    // Collision::AABB counts touching edges as overlap, so include tiles that only share a border.
+    auto floorDiv = [](int a, int b) { return a >= 0 ? a / b : -((-a + b - 1) / b); };
+    minX = floorDiv(rect.x - 1, scaledSize);
+    minY = floorDiv(rect.y - 1, scaledSize);
+    maxX = floorDiv(rect.x + rect.w, scaledSize);
+    maxY = floorDiv(rect.y + rect.h, scaledSize);
+}
+
+SDL_Rect Map::getTileRect(int tileX, int tileY) const {
+    return {tileX * scaledSize, tileY * scaledSize, scaledSize, scaledSize};
 }
 
-void Map::AddTile(int srcX, int srcY, int xpos, int ypos) {
-    auto& tile(manager_ref.addEntity());
-    tile.addComponent<TileComponent>(srcX, srcY, xpos, ypos, tileSize, mapscale, texID);
-    tile.addGroup(Game::groupMap);
+bool Map::overlapsSolid(const SDL_Rect& rect) const {
+    int minX, minY, maxX, maxY;
+    getTileRange(rect, minX, minY, maxX, maxY);
+    for (int ty = minY; ty <= maxY; ++ty) {
+        for (int tx = minX; tx <= maxX; ++tx) {
+            if (isSolid(tx, ty)) return true;
+        }
+    }
+    return false;
 }
\ No newline at end of file
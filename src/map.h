@@ -1,17 +1,52 @@
 #pragma once
 
+#include <SDL.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector> 
+#include "MapFile.h"
 #include "Vector2D.h" 
 #include "ECS/ECS.h"
 
+// The map stays memory-mapped for its whole lifetime. Only the chunks around
+// the camera are decoded and baked; a worker thread decodes the ring around
+// the view ahead of time, and chunks that drift out of range are dropped.
+// Collision and spawn queries give the same answer whether or not a chunk is
+// resident, reading straight from the mapping otherwise, so the simulation
+// never depends on streaming timing.
 class Map {
 public:
     Map(Manager& manager, std::string tID, int mscale, int tsize);
     ~Map();
 
-    void LoadMap(std::string path, int sizeX, int sizeY, int griWidth, std::vector<Vector2D>& outSpawnPoints);
-    void AddTile(int srcX, int srcY, int xpos, int ypos);
+    // Maps the compiled .mapb next to path, recompiling it first if the CSV is newer.
+    // The map takes its size from the file.
+    bool LoadMap(std::string path, int griWidth);
+    void updateStreaming(const SDL_Rect& view);
+    void draw();
+    // Re-bakes the resident chunks, e.g. after SDL_RENDER_TARGETS_RESET.
+    void bakeChunks();
+
+    static bool isSolidTileCode(int tileCode);
+    static bool isSpawnTileCode(int tileCode);
+    bool isSolid(int tileX, int tileY) const;
+    bool overlapsSolid(const SDL_Rect& rect) const;
+    void getTileRange(const SDL_Rect& rect, int& minX, int& minY, int& maxX, int& maxY) const;
+    SDL_Rect getTileRect(int tileX, int tileY) const;
+    // Spawn points in chunks within radiusChunks of the area, in row-major tile order.
+    void getSpawnPointsNear(const SDL_Rect& area, int radiusChunks, std::vector<Vector2D>& outSpawnPoints) const;
+
+    int getScaledSize() const { return scaledSize; }
+    int getWidthInTiles() const { return widthInTiles; }
+    int getHeightInTiles() const { return heightInTiles; }
+    int getPixelWidth() const { return widthInTiles * scaledSize; }
+    int getPixelHeight() const { return heightInTiles * scaledSize; }
+    std::size_t getResidentChunkCount() const { return residentChunks.size(); }
 
 private:
     Manager& manager_ref;
@@ -19,4 +54,54 @@ private:
     int mapscale;
     int tileSize;
     int scaledSize;
-};
\ No newline at end of file
+
+    int widthInTiles = 0;
+    int heightInTiles = 0;
+    int gridWidth = 1;
+
+    MappedFile mappedFile;
+    // Fallback image when the compiled map could not be written to disk.
+    std::vector<std::uint8_t> memoryImage;
+    MapFile::View view;
+    bool loaded = false;
+
+    struct MapChunk {
+        int index = 0;
+        int firstTileX = 0;
+        int firstTileY = 0;
+        int tilesW = 0;
+        int tilesH = 0;
+        SDL_Rect worldRect = {0, 0, 0, 0};
+        std::vector<int> tileCodes;
+        std::vector<std::uint64_t> solidBits;
+        std::vector<Vector2D> spawnPoints;
+        SDL_Texture* texture = nullptr;
+    };
+
+    // One slot per chunk; null unless resident.
+    std::vector<std::unique_ptr<MapChunk>> chunkSlots;
+    std::vector<char> chunkRequested;
+    std::vector<int> residentChunks;
+
+    std::thread streamThread;
+    std::mutex streamMutex;
+    std::condition_variable streamWake;
+    std::deque<int> streamRequests;
+    std::vector<std::unique_ptr<MapChunk>> streamResults;
+    bool streamStopping = false;
+
+    void startStreaming();
+    void stopStreaming();
+    void streamWorker();
+    void unload();
+
+    std::unique_ptr<MapChunk> decodeChunk(int index) const;
+    void installChunk(std::unique_ptr<MapChunk> chunk);
+    void evictChunk(int index);
+    void bakeChunk(MapChunk& chunk);
+    void getChunkRange(const SDL_Rect& area, int radiusChunks, int& minX, int& minY, int& maxX, int& maxY) const;
+    const MapChunk* residentChunkAt(int tileX, int tileY) const;
+
+    SDL_Rect getTileSrcRect(int tileCode) const;
+    void drawChunkTiles(SDL_Texture* tileset, const MapChunk& chunk, int offsetX, int offsetY);
+};